@@ -5,8 +5,11 @@
 #include "GameplayAbilitySpec.h"
 #include "../../Character/WoWEnemyCharacter.h"
 #include "../../Character/WoWPlayerCharacter.h"
+#include "../../Character/CombatantGridSubsystem.h"
 #include "../../States/WoWPlayerState.h"
+#include "../../Components/CombatStateComponent.h"
 #include "AbilitySystemGlobals.h"
+#include "../../WoWGameplayTags.h"
 
 UBTTask_PerformAttack::UBTTask_PerformAttack()
 {
@@ -44,8 +47,20 @@ EBTNodeResult::Type UBTTask_PerformAttack::ExecuteTask(UBehaviorTreeComponent& O
     AActor* TargetActor = Cast<AActor>(BlackboardComp->GetValueAsObject(TargetKey));
     if (!TargetActor)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to get Target Actor from Blackboard"));
-        return EBTNodeResult::Failed;
+        // Nothing sensed yet, pick up the nearest player within sight from the combatant grid
+        if (UCombatantGridSubsystem* CombatantGrid = UCombatantGridSubsystem::Get(EnemyCharacter))
+        {
+            TargetActor = CombatantGrid->FindNearest(EnemyCharacter->GetActorLocation(), EnemyCharacter->GetSightRadius(), 
+                ECombatFaction::Player, EnemyCharacter);
+        }
+        
+        if (!TargetActor)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Failed to get Target Actor from Blackboard"));
+            return EBTNodeResult::Failed;
+        }
+        
+        BlackboardComp->SetValueAsObject(TargetKey, TargetActor);
     }
     
     UE_LOG(LogTemp, Warning, TEXT("Target found: %s"), *TargetActor->GetName());
@@ -58,12 +73,16 @@ EBTNodeResult::Type UBTTask_PerformAttack::ExecuteTask(UBehaviorTreeComponent& O
         return EBTNodeResult::Failed;
     }
     
-    // Check for cooldown tag to avoid attacking too quickly
-    FGameplayTag CooldownTag = FGameplayTag::RequestGameplayTag(FName("Enemy.Attack.Cooldown"));
-    if (AbilitySystemComp->HasMatchingGameplayTag(CooldownTag))
+    // Check the attack cooldown (and that the enemy can act at all) with one mask test
+    FGameplayTag CooldownTag = WoWGameplayTags::Enemy_Attack_Cooldown;
+    const UCombatStateComponent* CombatState = EnemyCharacter->GetCombatStateComponent();
+    const bool bCannotAttack = CombatState ? 
+        CombatState->HasAnyState(ECombatStateFlags::AttackCooldown | CombatStateIncapacitated) : 
+        AbilitySystemComp->HasMatchingGameplayTag(CooldownTag);
+    if (bCannotAttack)
     {
         // Enemy is on cooldown, can't attack yet
-        UE_LOG(LogTemp, Warning, TEXT("Enemy attack on cooldown"));
+        UE_LOG(LogTemp, Warning, TEXT("Enemy attack on cooldown or incapacitated"));
         return EBTNodeResult::Failed;
     }
     
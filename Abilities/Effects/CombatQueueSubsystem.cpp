@@ -0,0 +1,153 @@
+// File: CombatQueueSubsystem.cpp
+#include "CombatQueueSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+UCombatQueueSubsystem* UCombatQueueSubsystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UCombatQueueSubsystem>() : nullptr;
+}
+
+bool UCombatQueueSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatQueueSubsystem::Deinitialize()
+{
+    TargetQueues.Empty();
+    TargetQueueIndices.Empty();
+    NumQueuedEffects = 0;
+
+    Super::Deinitialize();
+}
+
+TStatId UCombatQueueSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatQueueSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatQueueSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    Flush();
+}
+
+bool UCombatQueueSubsystem::CanMerge(const FQueuedEffect& Queued, const FGameplayEffectSpec& Incoming, const FGameplayTag& MergeTag)
+{
+    if (!MergeTag.IsValid() || Queued.MergeTag != MergeTag)
+    {
+        return false;
+    }
+
+    const FGameplayEffectSpec& QueuedSpec = *Queued.SpecHandle.Data.Get();
+
+    // An execution resolves each hit on its own (crit is rolled per execution), so summing hits would change the outcome
+    if (Incoming.Def->Executions.Num() > 0)
+    {
+        return false;
+    }
+
+    // Same effect, level and source, and nothing but the merge value set by the caller
+    return QueuedSpec.Def == Incoming.Def
+        && QueuedSpec.GetLevel() == Incoming.GetLevel()
+        && QueuedSpec.GetContext().GetInstigatorAbilitySystemComponent() == Incoming.GetContext().GetInstigatorAbilitySystemComponent()
+        && QueuedSpec.SetByCallerTagMagnitudes.Num() <= 1 && Incoming.SetByCallerTagMagnitudes.Num() <= 1
+        && QueuedSpec.SetByCallerNameMagnitudes.Num() == 0 && Incoming.SetByCallerNameMagnitudes.Num() == 0;
+}
+
+bool UCombatQueueSubsystem::EnqueueSpec(UAbilitySystemComponent* TargetASC, const FGameplayEffectSpecHandle& SpecHandle, const FGameplayTag& MergeTag,
+    const FOnQueuedEffectApplied& OnApplied)
+{
+    const FGameplayEffectSpec* Spec = SpecHandle.Data.Get();
+    if (!TargetASC || !Spec || !Spec->Def)
+    {
+        return false;
+    }
+
+    // Durations need their active handle right away, and clients keep applying (and predicting) directly
+    if (Spec->Def->DurationPolicy != EGameplayEffectDurationType::Instant || !TargetASC->IsOwnerActorAuthoritative())
+    {
+        return false;
+    }
+
+    const float Magnitude = MergeTag.IsValid() ? Spec->GetSetByCallerMagnitude(MergeTag, false) : 0.0f;
+
+    int32& TargetQueueIndex = TargetQueueIndices.FindOrAdd(TargetASC, INDEX_NONE);
+    if (TargetQueueIndex == INDEX_NONE)
+    {
+        TargetQueueIndex = TargetQueues.AddDefaulted();
+        TargetQueues[TargetQueueIndex].TargetASC = TargetASC;
+    }
+
+    FTargetQueue& TargetQueue = TargetQueues[TargetQueueIndex];
+
+    for (FQueuedEffect& Queued : TargetQueue.Effects)
+    {
+        if (CanMerge(Queued, *Spec, MergeTag))
+        {
+            Queued.MergedMagnitude += Magnitude;
+            if (OnApplied.IsBound())
+            {
+                Queued.OnApplied.Add(OnApplied);
+            }
+            return true;
+        }
+    }
+
+    FQueuedEffect& NewEffect = TargetQueue.Effects.AddDefaulted_GetRef();
+    NewEffect.SpecHandle = SpecHandle;
+    NewEffect.MergeTag = MergeTag;
+    NewEffect.MergedMagnitude = Magnitude;
+    if (OnApplied.IsBound())
+    {
+        NewEffect.OnApplied.Add(OnApplied);
+    }
+    ++NumQueuedEffects;
+
+    return true;
+}
+
+void UCombatQueueSubsystem::Flush()
+{
+    if (NumQueuedEffects == 0)
+    {
+        return;
+    }
+
+    // Take the queue so anything an application triggers (procs, death handling) lands in the next flush
+    TArray<FTargetQueue> FlushingQueues = MoveTemp(TargetQueues);
+    TargetQueues.Reset();
+    TargetQueueIndices.Reset();
+    NumQueuedEffects = 0;
+
+    for (FTargetQueue& TargetQueue : FlushingQueues)
+    {
+        UAbilitySystemComponent* TargetASC = TargetQueue.TargetASC.Get();
+
+        for (FQueuedEffect& Queued : TargetQueue.Effects)
+        {
+            bool bApplied = false;
+            if (TargetASC)
+            {
+                FGameplayEffectSpec& Spec = *Queued.SpecHandle.Data.Get();
+                if (Queued.MergeTag.IsValid())
+                {
+                    Spec.SetSetByCallerMagnitude(Queued.MergeTag, Queued.MergedMagnitude);
+                }
+
+                bApplied = TargetASC->ApplyGameplayEffectSpecToSelf(Spec).WasSuccessfullyApplied();
+            }
+
+            // A target that went away still reports, so callers waiting on the result are never left hanging
+            for (const FOnQueuedEffectApplied& OnApplied : Queued.OnApplied)
+            {
+                OnApplied.ExecuteIfBound(bApplied);
+            }
+        }
+    }
+}
@@ -0,0 +1,73 @@
+// File: CombatQueueSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayEffectTypes.h"
+#include "CombatQueueSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+
+// Called once a queued effect has been applied by the flush, with whether it took
+DECLARE_DELEGATE_OneParam(FOnQueuedEffectApplied, bool /*bApplied*/);
+
+// Server-side queue for instant gameplay effects. Abilities, auto-attacks and AI hand their specs in during
+// the frame and the queue applies them once per tick, grouped by target. Instant specs from the same source
+// with the same effect and level that only differ in their SetByCaller value are merged into one
+// application, so a target hit several times in a frame takes one attribute write, one
+// PostGameplayEffectExecute and one replication update per source and effect. Effects with executions are
+// never merged, since an execution resolves (and rolls crit for) each hit on its own.
+// Targets flush in the order they were first hit, and each target's effects in the order they arrived;
+// a merged effect keeps the position of its first hit
+UCLASS()
+class MYPROJECT5_API UCombatQueueSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // The queue for the world the object lives in, nullptr outside game worlds
+    static UCombatQueueSubsystem* Get(const UObject* WorldContextObject);
+
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Defer an instant spec to this frame's flush. MergeTag is the SetByCaller tag whose values are summed
+    // when merging (invalid never merges). Returns false if the spec cannot be deferred (not instant, or the
+    // target is not authoritative here), in which case the caller should apply it immediately.
+    // OnApplied runs after the flush has applied the spec, once per enqueue even when merged
+    bool EnqueueSpec(UAbilitySystemComponent* TargetASC, const FGameplayEffectSpecHandle& SpecHandle, const FGameplayTag& MergeTag,
+        const FOnQueuedEffectApplied& OnApplied = FOnQueuedEffectApplied());
+
+    // Apply everything queued so far. Effects queued while flushing wait for the next flush
+    void Flush();
+
+    int32 GetNumQueuedEffects() const { return NumQueuedEffects; }
+
+protected:
+    struct FQueuedEffect
+    {
+        FGameplayEffectSpecHandle SpecHandle;
+        FGameplayTag MergeTag;
+        float MergedMagnitude = 0.0f;
+        TArray<FOnQueuedEffectApplied, TInlineAllocator<1>> OnApplied;
+    };
+
+    struct FTargetQueue
+    {
+        TWeakObjectPtr<UAbilitySystemComponent> TargetASC;
+        TArray<FQueuedEffect, TInlineAllocator<4>> Effects;
+    };
+
+    // True if Incoming can be folded into Queued
+    static bool CanMerge(const FQueuedEffect& Queued, const FGameplayEffectSpec& Incoming, const FGameplayTag& MergeTag);
+
+    // Targets in first-hit order
+    TArray<FTargetQueue> TargetQueues;
+
+    // Target ASC -> index into TargetQueues. Only compared, never dereferenced
+    TMap<const UAbilitySystemComponent*, int32> TargetQueueIndices;
+
+    int32 NumQueuedEffects = 0;
+};
@@ -0,0 +1,300 @@
+// File: EffectFeedbackSubsystem.cpp
+#include "EffectFeedbackSubsystem.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "Components/AudioComponent.h"
+#include "Sound/SoundBase.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+UEffectFeedbackSubsystem* UEffectFeedbackSubsystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UEffectFeedbackSubsystem>() : nullptr;
+}
+
+bool UEffectFeedbackSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    // Nothing is ever seen or heard on a dedicated server
+    return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool UEffectFeedbackSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEffectFeedbackSubsystem::Deinitialize()
+{
+    for (UNiagaraComponent* Component : NiagaraComponents)
+    {
+        if (IsValid(Component))
+        {
+            Component->OnSystemFinished.RemoveAll(this);
+            Component->DestroyComponent();
+        }
+    }
+
+    for (UAudioComponent* Component : AudioComponents)
+    {
+        if (IsValid(Component))
+        {
+            Component->DestroyComponent();
+        }
+    }
+
+    NiagaraComponents.Empty();
+    AudioComponents.Empty();
+    FreeSystems.Empty();
+    ActiveSystems.Empty();
+    ActiveSystemsPerEffect.Empty();
+    SoundComponents.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UEffectFeedbackSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UEffectFeedbackSubsystem, STATGROUP_Tickables);
+}
+
+void UEffectFeedbackSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    SpawnsThisFrame = 0;
+
+    // Cache the local view once per frame for the distance cull
+    if (APlayerController* PlayerController = GetWorld()->GetFirstPlayerController())
+    {
+        FRotator ViewRotation;
+        PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+        ViewPawn = PlayerController->GetPawn();
+    }
+
+    // Components destroyed out from under us (world teardown, level streaming) never report finishing
+    for (auto It = ActiveSystems.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().IsValid())
+        {
+            if (int32* Count = ActiveSystemsPerEffect.Find(It.Value()))
+            {
+                --(*Count);
+            }
+            It.RemoveCurrent();
+        }
+    }
+
+    NiagaraComponents.RemoveAllSwap([](const UNiagaraComponent* Component) { return !IsValid(Component); });
+    AudioComponents.RemoveAllSwap([](const UAudioComponent* Component) { return !IsValid(Component); });
+}
+
+bool UEffectFeedbackSubsystem::PassesBudget(const FVector& Location, const AActor* Target, const AActor* Instigator) const
+{
+    const AActor* LocalPawn = ViewPawn.Get();
+    if (LocalPawn && (Target == LocalPawn || Instigator == LocalPawn))
+    {
+        return true;
+    }
+
+    return SpawnsThisFrame < MaxSpawnsPerFrame && FVector::DistSquared(ViewLocation, Location) <= FMath::Square(CullDistance);
+}
+
+UNiagaraComponent* UEffectFeedbackSubsystem::PlayAttached(UNiagaraSystem* System, AActor* Target, int32 EffectID, const AActor* Instigator)
+{
+    USceneComponent* AttachParent = Target ? Target->GetRootComponent() : nullptr;
+    if (!System || !AttachParent)
+    {
+        return nullptr;
+    }
+
+    int32& ActiveForEffect = ActiveSystemsPerEffect.FindOrAdd(EffectID);
+    if (ActiveForEffect >= MaxInstancesPerEffect || !PassesBudget(AttachParent->GetComponentLocation(), Target, Instigator))
+    {
+        return nullptr;
+    }
+
+    UNiagaraComponent* Component = AcquireNiagaraComponent(System);
+    if (!Component)
+    {
+        return nullptr;
+    }
+
+    Component->AttachToComponent(AttachParent, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+    Component->Activate(true);
+
+    ActiveSystems.Add(Component, EffectID);
+    ++ActiveForEffect;
+    ++SpawnsThisFrame;
+
+    return Component;
+}
+
+UNiagaraComponent* UEffectFeedbackSubsystem::AcquireNiagaraComponent(UNiagaraSystem* System)
+{
+    if (TArray<TWeakObjectPtr<UNiagaraComponent>, TInlineAllocator<8>>* FreeComponents = FreeSystems.Find(System))
+    {
+        while (FreeComponents->Num() > 0)
+        {
+            UNiagaraComponent* Component = FreeComponents->Pop(false).Get();
+            if (IsValid(Component))
+            {
+                return Component;
+            }
+        }
+    }
+
+    UWorld* World = GetWorld();
+    UNiagaraComponent* Component = NewObject<UNiagaraComponent>(World);
+    Component->SetAsset(System);
+    Component->SetAutoDestroy(false);
+    Component->bAutoActivate = false;
+    Component->OnSystemFinished.AddDynamic(this, &UEffectFeedbackSubsystem::OnNiagaraFinished);
+    Component->RegisterComponentWithWorld(World);
+
+    NiagaraComponents.Add(Component);
+    return Component;
+}
+
+void UEffectFeedbackSubsystem::ReleaseNiagaraComponent(UNiagaraComponent* Component)
+{
+    int32 EffectID = INDEX_NONE;
+    if (!ActiveSystems.RemoveAndCopyValue(Component, EffectID))
+    {
+        return;
+    }
+
+    if (int32* Count = ActiveSystemsPerEffect.Find(EffectID))
+    {
+        --(*Count);
+    }
+
+    Component->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+    FreeSystems.FindOrAdd(Component->GetAsset()).Add(Component);
+}
+
+void UEffectFeedbackSubsystem::OnNiagaraFinished(UNiagaraComponent* FinishedComponent)
+{
+    if (IsValid(FinishedComponent))
+    {
+        ReleaseNiagaraComponent(FinishedComponent);
+    }
+}
+
+UAudioComponent* UEffectFeedbackSubsystem::PlaySoundAt(USoundBase* Sound, const FVector& Location, const AActor* Target, const AActor* Instigator)
+{
+    if (!Sound || !PassesBudget(Location, Target, Instigator))
+    {
+        return nullptr;
+    }
+
+    TArray<TWeakObjectPtr<UAudioComponent>, TInlineAllocator<4>>& Components = GetSoundComponents(Sound);
+
+    if (UAudioComponent* Component = FindIdleAudioComponent(Components))
+    {
+        // May have last played attached to someone
+        Component->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+        Component->SetWorldLocation(Location);
+        Component->Play();
+        ++SpawnsThisFrame;
+        return Component;
+    }
+
+    if (Components.Num() >= MaxAudioPerSound)
+    {
+        return nullptr;
+    }
+
+    UAudioComponent* Component = UGameplayStatics::SpawnSoundAtLocation(GetWorld(), Sound, Location,
+        FRotator::ZeroRotator, 1.0f, 1.0f, 0.0f, nullptr, nullptr, false);
+    return AddAudioComponent(Components, Component);
+}
+
+UAudioComponent* UEffectFeedbackSubsystem::PlaySoundAttached(USoundBase* Sound, AActor* Target, const AActor* Instigator)
+{
+    USceneComponent* AttachParent = Target ? Target->GetRootComponent() : nullptr;
+    if (!Sound || !AttachParent || !PassesBudget(AttachParent->GetComponentLocation(), Target, Instigator))
+    {
+        return nullptr;
+    }
+
+    TArray<TWeakObjectPtr<UAudioComponent>, TInlineAllocator<4>>& Components = GetSoundComponents(Sound);
+
+    if (UAudioComponent* Component = FindIdleAudioComponent(Components))
+    {
+        Component->AttachToComponent(AttachParent, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+        Component->Play();
+        ++SpawnsThisFrame;
+        return Component;
+    }
+
+    if (Components.Num() >= MaxAudioPerSound)
+    {
+        return nullptr;
+    }
+
+    UAudioComponent* Component = UGameplayStatics::SpawnSoundAttached(Sound, AttachParent, NAME_None, FVector::ZeroVector,
+        EAttachLocation::SnapToTarget, true, 1.0f, 1.0f, 0.0f, nullptr, nullptr, false);
+    return AddAudioComponent(Components, Component);
+}
+
+TArray<TWeakObjectPtr<UAudioComponent>, TInlineAllocator<4>>& UEffectFeedbackSubsystem::GetSoundComponents(const USoundBase* Sound)
+{
+    TArray<TWeakObjectPtr<UAudioComponent>, TInlineAllocator<4>>& Components = SoundComponents.FindOrAdd(Sound);
+    Components.RemoveAllSwap([](const TWeakObjectPtr<UAudioComponent>& Component) { return !Component.IsValid(); });
+    return Components;
+}
+
+UAudioComponent* UEffectFeedbackSubsystem::FindIdleAudioComponent(const TArray<TWeakObjectPtr<UAudioComponent>, TInlineAllocator<4>>& Components)
+{
+    // Reuse the first idle component for this sound
+    for (const TWeakObjectPtr<UAudioComponent>& WeakComponent : Components)
+    {
+        UAudioComponent* Component = WeakComponent.Get();
+        if (!Component->IsPlaying())
+        {
+            return Component;
+        }
+    }
+
+    return nullptr;
+}
+
+UAudioComponent* UEffectFeedbackSubsystem::AddAudioComponent(TArray<TWeakObjectPtr<UAudioComponent>, TInlineAllocator<4>>& Components, UAudioComponent* Component)
+{
+    if (!Component)
+    {
+        return nullptr;
+    }
+
+    Components.Add(Component);
+    AudioComponents.Add(Component);
+    ++SpawnsThisFrame;
+    return Component;
+}
+
+void UEffectFeedbackSubsystem::StopAttached(UNiagaraComponent* Component, const AActor* Target)
+{
+    if (!IsValid(Component) || !ActiveSystems.Contains(Component))
+    {
+        return;
+    }
+
+    // A released component may already be playing for someone else
+    const USceneComponent* AttachParent = Component->GetAttachParent();
+    if (AttachParent && AttachParent->GetOwner() == Target)
+    {
+        // Lets the particles die out; OnSystemFinished hands it back to the pool
+        Component->Deactivate();
+    }
+}
+
+void UEffectFeedbackSubsystem::StopSound(UAudioComponent* Component, const USoundBase* Sound)
+{
+    if (IsValid(Component) && Component->Sound == Sound && Component->IsPlaying())
+    {
+        Component->Stop();
+    }
+}
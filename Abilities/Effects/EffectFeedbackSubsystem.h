@@ -0,0 +1,105 @@
+// File: EffectFeedbackSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EffectFeedbackSubsystem.generated.h"
+
+class UNiagaraSystem;
+class UNiagaraComponent;
+class USoundBase;
+class UAudioComponent;
+
+// Client-side player for effect VFX and sounds. Niagara and audio components are recycled per asset
+// instead of being spawned and destroyed per hit, and every request goes through the same gates:
+// a per-frame spawn budget, a distance cull from the local view and a cap on concurrent instances per effect.
+// Feedback on or from the locally viewed pawn is always significant and skips the budget and the cull
+UCLASS()
+class MYPROJECT5_API UEffectFeedbackSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // The feedback player for the world the object lives in, nullptr on dedicated servers and outside game worlds
+    static UEffectFeedbackSubsystem* Get(const UObject* WorldContextObject);
+
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Play System attached to Target's root. Returns the running component, nullptr if it was culled or capped.
+    // The component goes back to the pool when the system finishes or is deactivated
+    UNiagaraComponent* PlayAttached(UNiagaraSystem* System, AActor* Target, int32 EffectID, const AActor* Instigator);
+
+    // Play Sound at Location. Returns the playing component, nullptr if it was culled or every pooled component for the sound is busy
+    UAudioComponent* PlaySoundAt(USoundBase* Sound, const FVector& Location, const AActor* Target, const AActor* Instigator);
+
+    // Play Sound attached to Target's root so it follows the target. Same pool and gates as PlaySoundAt
+    UAudioComponent* PlaySoundAttached(USoundBase* Sound, AActor* Target, const AActor* Instigator);
+
+    // Stop a system started by PlayAttached, unless it already finished and went to another target
+    void StopAttached(UNiagaraComponent* Component, const AActor* Target);
+
+    // Stop a sound started by PlaySoundAt or PlaySoundAttached, unless the component has moved on to another play
+    void StopSound(UAudioComponent* Component, const USoundBase* Sound);
+
+    int32 GetNumActiveSystems() const { return ActiveSystems.Num(); }
+
+protected:
+    // True if feedback at Location passes the distance cull and the frame budget
+    bool PassesBudget(const FVector& Location, const AActor* Target, const AActor* Instigator) const;
+
+    UNiagaraComponent* AcquireNiagaraComponent(UNiagaraSystem* System);
+
+    void ReleaseNiagaraComponent(UNiagaraComponent* Component);
+
+    // Sound's pooled audio components, with destroyed ones pruned
+    TArray<TWeakObjectPtr<UAudioComponent>, TInlineAllocator<4>>& GetSoundComponents(const USoundBase* Sound);
+
+    static UAudioComponent* FindIdleAudioComponent(const TArray<TWeakObjectPtr<UAudioComponent>, TInlineAllocator<4>>& Components);
+
+    // Pool a freshly spawned, already playing component. Returns it, nullptr if the spawn failed
+    UAudioComponent* AddAudioComponent(TArray<TWeakObjectPtr<UAudioComponent>, TInlineAllocator<4>>& Components, UAudioComponent* Component);
+
+    UFUNCTION()
+    void OnNiagaraFinished(UNiagaraComponent* FinishedComponent);
+
+    // Spawns allowed per frame for feedback that is not significant
+    int32 MaxSpawnsPerFrame = 12;
+
+    // Most running systems per effect ID
+    int32 MaxInstancesPerEffect = 16;
+
+    // Most pooled audio components per sound, which is also its concurrency cap
+    int32 MaxAudioPerSound = 4;
+
+    // Feedback further than this from the local view is dropped
+    float CullDistance = 5000.0f;
+
+    int32 SpawnsThisFrame = 0;
+
+    // Refreshed every tick from the first local player
+    FVector ViewLocation = FVector::ZeroVector;
+    TWeakObjectPtr<const AActor> ViewPawn;
+
+    // Every component the pool created, keeps them alive
+    UPROPERTY()
+    TArray<UNiagaraComponent*> NiagaraComponents;
+
+    UPROPERTY()
+    TArray<UAudioComponent*> AudioComponents;
+
+    // Idle Niagara components per system
+    TMap<const UNiagaraSystem*, TArray<TWeakObjectPtr<UNiagaraComponent>, TInlineAllocator<8>>> FreeSystems;
+
+    // Running Niagara component -> effect ID
+    TMap<TWeakObjectPtr<const UNiagaraComponent>, int32> ActiveSystems;
+
+    // Effect ID -> running systems
+    TMap<int32, int32> ActiveSystemsPerEffect;
+
+    // Audio components per sound, busy or not
+    TMap<const USoundBase*, TArray<TWeakObjectPtr<UAudioComponent>, TInlineAllocator<4>>> SoundComponents;
+};
@@ -0,0 +1,41 @@
+// File: EffectSpecCache.cpp
+#include "EffectSpecCache.h"
+#include "AbilitySystemGlobals.h"
+
+FGameplayEffectSpecHandle FEffectSpecCache::MakeSpec(int32 EffectID, const UGameplayEffect* EffectDef, float Level,
+    const FGameplayEffectContextHandle& Context, const FGameplayTag& SetByCallerTag, float Magnitude)
+{
+    if (!EffectDef || !Context.IsValid())
+    {
+        return FGameplayEffectSpecHandle();
+    }
+
+    const FTemplateKey Key{ EffectID, Level };
+
+    FGameplayEffectSpec* Template = Templates.Find(Key);
+    if (!Template || Template->Def != EffectDef)
+    {
+        // Full initialization happens here, once per effect and level. The template gets an empty context of
+        // its own so no caller's instigator or hit data is kept in it
+        const FGameplayEffectContextHandle TemplateContext(UAbilitySystemGlobals::Get().AllocGameplayEffectContext());
+        Template = &Templates.Add(Key, FGameplayEffectSpec(EffectDef, TemplateContext, Level));
+
+        // Reserve the SetByCaller entry so clones only overwrite a value
+        if (SetByCallerTag.IsValid())
+        {
+            Template->SetSetByCallerMagnitude(SetByCallerTag, 0.0f);
+        }
+    }
+
+    FGameplayEffectSpec* NewSpec = new FGameplayEffectSpec(*Template);
+
+    // Every spec gets the caller's context; swapping it on an initialized spec recaptures source tags and attributes
+    NewSpec->SetContext(Context);
+
+    if (SetByCallerTag.IsValid())
+    {
+        NewSpec->SetSetByCallerMagnitude(SetByCallerTag, Magnitude);
+    }
+
+    return FGameplayEffectSpecHandle(NewSpec);
+}
@@ -0,0 +1,45 @@
+// File: EffectSpecCache.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+
+// Per-source cache of prebuilt gameplay effect specs, keyed by (EffectID, Level).
+// The first hit builds a template spec, which runs the capture-definition and tag setup once. Templates
+// hold an empty context, never a caller's. Every hit copies the template and patches in its own context
+// and the SetByCaller magnitude.
+// Keep one cache per source (component or instanced ability), since templates are not shared between actors.
+class MYPROJECT5_API FEffectSpecCache
+{
+public:
+    // Clone the template for this effect and level, give it the caller's context (which recaptures
+    // source tags and attributes) and set the SetByCaller magnitude if the tag is valid.
+    // EffectID only needs to be unique within this cache. If EffectDef no longer matches the cached
+    // template (e.g. a hotfix swapped the GE class), the template is rebuilt
+    FGameplayEffectSpecHandle MakeSpec(int32 EffectID, const UGameplayEffect* EffectDef, float Level,
+        const FGameplayEffectContextHandle& Context, const FGameplayTag& SetByCallerTag, float Magnitude);
+
+    // Drop every template
+    void Reset() { Templates.Reset(); }
+
+    int32 Num() const { return Templates.Num(); }
+
+private:
+    struct FTemplateKey
+    {
+        int32 EffectID;
+        float Level;
+
+        bool operator==(const FTemplateKey& Other) const
+        {
+            return EffectID == Other.EffectID && Level == Other.Level;
+        }
+
+        friend uint32 GetTypeHash(const FTemplateKey& Key)
+        {
+            return HashCombine(::GetTypeHash(Key.EffectID), ::GetTypeHash(Key.Level));
+        }
+    };
+
+    TMap<FTemplateKey, FGameplayEffectSpec> Templates;
+};
@@ -1,5 +1,6 @@
 // GE_AbilityCooldown.cpp
 #include "GE_AbilityCooldown.h"
+#include "../../WoWGameplayTags.h"
 
 UGE_AbilityCooldown::UGE_AbilityCooldown()
 {
@@ -11,5 +12,5 @@ UGE_AbilityCooldown::UGE_AbilityCooldown()
     DurationMagnitude = FScalableFloat(5.0f); // Default duration
     
     // Add cooldown tag to the effect
-    InheritableOwnedTagsContainer.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Cooldown")));
+    InheritableOwnedTagsContainer.AddTag(WoWGameplayTags::Ability_Cooldown);
 }
\ No newline at end of file
@@ -0,0 +1,295 @@
+// File: PeriodicEffectSubsystem.cpp
+#include "PeriodicEffectSubsystem.h"
+#include "CombatQueueSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "../../WoWGameplayTags.h"
+
+UPeriodicEffectSubsystem* UPeriodicEffectSubsystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UPeriodicEffectSubsystem>() : nullptr;
+}
+
+bool UPeriodicEffectSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPeriodicEffectSubsystem::Deinitialize()
+{
+    for (TArray<int32>& Bucket : Wheel)
+    {
+        Bucket.Empty();
+    }
+
+    Effects.Empty();
+    TargetEffects.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UPeriodicEffectSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UPeriodicEffectSubsystem, STATGROUP_Tickables);
+}
+
+void UPeriodicEffectSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    TicksLastFrame = 0;
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    const int64 NowSlot = GetSlotForTime(Now);
+
+    if (Effects.Num() == 0)
+    {
+        CurrentSlot = NowSlot;
+        return;
+    }
+
+    // Take every tick that is due out of the wheel. A hitch longer than a lap still visits each bucket once
+    TArray<FDueEffect, TInlineAllocator<64>> DueEffects;
+    for (int64 Slot = FMath::Max(CurrentSlot, NowSlot - NumSlots + 1); Slot <= NowSlot; ++Slot)
+    {
+        TArray<int32>& Bucket = Wheel[static_cast<int32>(Slot % NumSlots)];
+        for (int32 BucketIndex = Bucket.Num() - 1; BucketIndex >= 0; --BucketIndex)
+        {
+            FPeriodicEffect& Effect = Effects[Bucket[BucketIndex]];
+
+            // Later laps, and ticks later in the slot we are still in
+            if (Effect.DueSlot > NowSlot || Effect.GetNextTickTime() > Now)
+            {
+                continue;
+            }
+
+            Effect.DueSlot = INDEX_NONE;
+            DueEffects.Add({ Bucket[BucketIndex], Effect.Sequence, Effect.GetNextTickTime() });
+            Bucket.RemoveAtSwap(BucketIndex, 1, false);
+        }
+    }
+
+    // The current slot is revisited next frame for the ticks still ahead in it
+    CurrentSlot = NowSlot;
+
+    if (DueEffects.Num() == 0)
+    {
+        return;
+    }
+
+    // Same order every run regardless of bucket layout
+    DueEffects.Sort([](const FDueEffect& A, const FDueEffect& B)
+    {
+        return A.TickTime != B.TickTime ? A.TickTime < B.TickTime : A.Sequence < B.Sequence;
+    });
+
+    // The combat queue groups the ticks by target
+    UCombatQueueSubsystem* CombatQueue = UCombatQueueSubsystem::Get(this);
+
+    for (const FDueEffect& Due : DueEffects)
+    {
+        // Callbacks of an earlier tick may have cancelled this effect or reused its index
+        if (!IsSameEffect(Due.Index, Due.Sequence))
+        {
+            continue;
+        }
+
+        FPeriodicEffect& Effect = Effects[Due.Index];
+
+        UAbilitySystemComponent* TargetASC = Effect.TargetASC.Get();
+        if (!TargetASC || TargetASC->HasMatchingGameplayTag(WoWGameplayTags::State_Dead))
+        {
+            RemoveEffect(Due.Index);
+            continue;
+        }
+
+        int32 NumTicks = 0;
+        double NextTickTime = Effect.GetNextTickTime();
+        while (NextTickTime <= Now && NextTickTime <= Effect.EndTime + UE_KINDA_SMALL_NUMBER)
+        {
+            ++Effect.TicksFired;
+            ++NumTicks;
+            NextTickTime = Effect.GetNextTickTime();
+        }
+
+        // Applying runs attribute and tag callbacks that can schedule or cancel effects and move Effects,
+        // so nothing below holds on to the entry
+        const FGameplayEffectSpecHandle TickTemplate = Effect.TickSpec;
+        const FGameplayTag MergeTag = Effect.MergeTag;
+
+        for (int32 TickIndex = 0; TickIndex < NumTicks; ++TickIndex)
+        {
+            // The queue writes merged values into the spec it holds, so every tick gets its own copy
+            FGameplayEffectSpecHandle TickSpec(new FGameplayEffectSpec(*TickTemplate.Data.Get()));
+            if (!CombatQueue || !CombatQueue->EnqueueSpec(TargetASC, TickSpec, MergeTag))
+            {
+                TargetASC->ApplyGameplayEffectSpecToSelf(*TickSpec.Data.Get());
+            }
+        }
+
+        TicksLastFrame += NumTicks;
+
+        if (IsSameEffect(Due.Index, Due.Sequence) && !InsertIntoWheel(Due.Index))
+        {
+            RemoveEffect(Due.Index);
+        }
+    }
+
+    TotalTicks += TicksLastFrame;
+
+    if (CombatQueue)
+    {
+        CombatQueue->Flush();
+    }
+}
+
+FPeriodicEffectHandle UPeriodicEffectSubsystem::ScheduleEffect(UAbilitySystemComponent* TargetASC, const FGameplayEffectSpec& TickSpec, int32 EffectID,
+    const FGameplayTag& MergeTag, float Period, float Duration)
+{
+    if (!TargetASC || !TickSpec.Def || Period <= 0.0f || Duration < Period)
+    {
+        return FPeriodicEffectHandle();
+    }
+
+    // Ticks are applied whole each time, and only the server runs them
+    if (TickSpec.Def->DurationPolicy != EGameplayEffectDurationType::Instant || !TargetASC->IsOwnerActorAuthoritative())
+    {
+        return FPeriodicEffectHandle();
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    if (Effects.Num() == 0)
+    {
+        CurrentSlot = GetSlotForTime(Now);
+    }
+
+    const UAbilitySystemComponent* SourceASC = TickSpec.GetContext().GetInstigatorAbilitySystemComponent();
+    FGameplayEffectSpecHandle SpecCopy(new FGameplayEffectSpec(TickSpec));
+
+    TArray<int32, TInlineAllocator<4>>& OnTarget = TargetEffects.FindOrAdd(TargetASC);
+    for (int32 EffectIndex : OnTarget)
+    {
+        FPeriodicEffect& Existing = Effects[EffectIndex];
+        if (Existing.EffectID == EffectID && Existing.SourceASC.Get() == SourceASC)
+        {
+            // Refresh: new values and end time, the running ticks keep their phase and period
+            Existing.TickSpec = SpecCopy;
+            Existing.MergeTag = MergeTag;
+            Existing.EndTime = Now + Duration;
+            return { EffectIndex, Existing.Sequence };
+        }
+    }
+
+    FPeriodicEffect NewEffect;
+    NewEffect.TargetASC = TargetASC;
+    NewEffect.SourceASC = SourceASC;
+    NewEffect.TickSpec = SpecCopy;
+    NewEffect.MergeTag = MergeTag;
+    NewEffect.EffectID = EffectID;
+    NewEffect.StartTime = Now;
+    NewEffect.EndTime = Now + Duration;
+    NewEffect.Period = FMath::Max(Period, static_cast<float>(SlotDuration));
+    NewEffect.Sequence = NextSequence++;
+
+    const int32 EffectIndex = Effects.Add(MoveTemp(NewEffect));
+    OnTarget.Add(EffectIndex);
+
+    if (!InsertIntoWheel(EffectIndex))
+    {
+        RemoveEffect(EffectIndex);
+        return FPeriodicEffectHandle();
+    }
+
+    return { EffectIndex, Effects[EffectIndex].Sequence };
+}
+
+bool UPeriodicEffectSubsystem::InsertIntoWheel(int32 EffectIndex)
+{
+    FPeriodicEffect& Effect = Effects[EffectIndex];
+
+    const double NextTickTime = Effect.GetNextTickTime();
+    if (NextTickTime > Effect.EndTime + UE_KINDA_SMALL_NUMBER)
+    {
+        return false;
+    }
+
+    Effect.DueSlot = FMath::Max(GetSlotForTime(NextTickTime), CurrentSlot);
+    Wheel[static_cast<int32>(Effect.DueSlot % NumSlots)].Add(EffectIndex);
+    return true;
+}
+
+void UPeriodicEffectSubsystem::RemoveEffect(int32 EffectIndex)
+{
+    FPeriodicEffect& Effect = Effects[EffectIndex];
+
+    if (Effect.DueSlot != INDEX_NONE)
+    {
+        Wheel[static_cast<int32>(Effect.DueSlot % NumSlots)].RemoveSingleSwap(EffectIndex, false);
+    }
+
+    // Stale weak keys still hash to their entry, so effects on destroyed targets are found too
+    const TWeakObjectPtr<const UAbilitySystemComponent> TargetKey = Effect.TargetASC;
+    if (TArray<int32, TInlineAllocator<4>>* OnTarget = TargetEffects.Find(TargetKey))
+    {
+        OnTarget->RemoveSingleSwap(EffectIndex, false);
+        if (OnTarget->Num() == 0)
+        {
+            TargetEffects.Remove(TargetKey);
+        }
+    }
+
+    // Listeners hear about it once the entry is gone, so anything they schedule or cancel sees the final state
+    const FPeriodicEffectHandle Handle{ EffectIndex, Effect.Sequence };
+    const FOnPeriodicEffectEnded OnEnded = MoveTemp(Effect.OnEnded);
+
+    Effects.RemoveAt(EffectIndex);
+
+    OnEnded.Broadcast(Handle);
+}
+
+FOnPeriodicEffectEnded* UPeriodicEffectSubsystem::OnPeriodicEffectEnded(FPeriodicEffectHandle Handle)
+{
+    return IsSameEffect(Handle.Index, Handle.Sequence) ? &Effects[Handle.Index].OnEnded : nullptr;
+}
+
+int32 UPeriodicEffectSubsystem::CancelEffect(const UAbilitySystemComponent* TargetASC, int32 EffectID, const UAbilitySystemComponent* SourceASC)
+{
+    const TArray<int32, TInlineAllocator<4>>* OnTarget = TargetEffects.Find(TargetASC);
+    if (!OnTarget)
+    {
+        return 0;
+    }
+
+    // Removing edits the target's list
+    TArray<int32, TInlineAllocator<4>> ToRemove;
+    for (int32 EffectIndex : *OnTarget)
+    {
+        const FPeriodicEffect& Effect = Effects[EffectIndex];
+        if (Effect.EffectID == EffectID && (!SourceASC || Effect.SourceASC.Get() == SourceASC))
+        {
+            ToRemove.Add(EffectIndex);
+        }
+    }
+
+    for (int32 EffectIndex : ToRemove)
+    {
+        RemoveEffect(EffectIndex);
+    }
+
+    return ToRemove.Num();
+}
+
+void UPeriodicEffectSubsystem::CancelAllOnTarget(const UAbilitySystemComponent* TargetASC)
+{
+    if (const TArray<int32, TInlineAllocator<4>>* OnTarget = TargetEffects.Find(TargetASC))
+    {
+        const TArray<int32, TInlineAllocator<4>> ToRemove = *OnTarget;
+        for (int32 EffectIndex : ToRemove)
+        {
+            RemoveEffect(EffectIndex);
+        }
+    }
+}
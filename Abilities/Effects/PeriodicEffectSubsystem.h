@@ -0,0 +1,128 @@
+// File: PeriodicEffectSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/StaticArray.h"
+#include "GameplayEffectTypes.h"
+#include "PeriodicEffectSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+struct FGameplayEffectSpec;
+
+// One running periodic effect. A refresh keeps the handle, an index reused by a later effect does not match it
+struct FPeriodicEffectHandle
+{
+    int32 Index = INDEX_NONE;
+    uint32 Sequence = 0;
+
+    bool IsValid() const { return Index != INDEX_NONE; }
+    bool operator==(const FPeriodicEffectHandle& Other) const { return Index == Other.Index && Sequence == Other.Sequence; }
+    bool operator!=(const FPeriodicEffectHandle& Other) const { return !(*this == Other); }
+};
+
+// Fired once when a periodic effect runs out, is cancelled or loses its target
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPeriodicEffectEnded, FPeriodicEffectHandle);
+
+// Server-side scheduler for table-driven DoT and HoT ticks. Every running periodic effect in the world sits
+// in one timing wheel instead of owning a timer, and each tick the wheel hands the ticks that came due to
+// the combat queue and flushes it, so a frame's ticks land in one pass grouped by target.
+// Tick N of an effect is due at exactly StartTime + N * Period. Nothing is accumulated frame to frame, so
+// late frames never drift an effect, and the period is fixed when the effect starts, so nothing that
+// changes afterwards moves ticks that are already running. A refresh keeps the running ticks' phase
+// and only extends the end time
+UCLASS()
+class MYPROJECT5_API UPeriodicEffectSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // The scheduler for the world the object lives in, nullptr outside game worlds
+    static UPeriodicEffectSubsystem* Get(const UObject* WorldContextObject);
+
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // Tick a copy of TickSpec on TargetASC every Period seconds for Duration seconds, first tick one period
+    // from now. Scheduling the same effect from the same source on the same target again refreshes it.
+    // MergeTag is passed on to the combat queue. Returns an invalid handle if the spec cannot be scheduled
+    // (not instant, target not authoritative here, or a duration shorter than one period)
+    FPeriodicEffectHandle ScheduleEffect(UAbilitySystemComponent* TargetASC, const FGameplayEffectSpec& TickSpec, int32 EffectID,
+        const FGameplayTag& MergeTag, float Period, float Duration);
+
+    // Stop EffectID on TargetASC, from SourceASC only if one is given. Returns how many were stopped
+    int32 CancelEffect(const UAbilitySystemComponent* TargetASC, int32 EffectID, const UAbilitySystemComponent* SourceASC = nullptr);
+
+    // Stop everything ticking on TargetASC
+    void CancelAllOnTarget(const UAbilitySystemComponent* TargetASC);
+
+    // Delegate fired when the effect ends, nullptr if it already has
+    FOnPeriodicEffectEnded* OnPeriodicEffectEnded(FPeriodicEffectHandle Handle);
+
+    // Profiling counters
+    int32 GetNumScheduledEffects() const { return Effects.Num(); }
+    int32 GetNumTickedTargets() const { return TargetEffects.Num(); }
+    int32 GetTicksLastFrame() const { return TicksLastFrame; }
+    int64 GetTotalTicks() const { return TotalTicks; }
+
+protected:
+    struct FPeriodicEffect
+    {
+        TWeakObjectPtr<UAbilitySystemComponent> TargetASC;
+        TWeakObjectPtr<const UAbilitySystemComponent> SourceASC;
+        FGameplayEffectSpecHandle TickSpec;
+        FGameplayTag MergeTag;
+        int32 EffectID = INDEX_NONE;
+        double StartTime = 0.0;
+        double EndTime = 0.0;
+        float Period = 0.0f;
+        int32 TicksFired = 0;
+        // Wheel slot of the next tick, counted from the first slot ever, so later laps are told apart
+        int64 DueSlot = 0;
+        // Tie break for ticks due at the same time, in scheduling order
+        uint32 Sequence = 0;
+        FOnPeriodicEffectEnded OnEnded;
+
+        double GetNextTickTime() const { return StartTime + (TicksFired + 1) * static_cast<double>(Period); }
+    };
+
+    // A tick taken out of the wheel this frame. Sequence tells a reused index apart from the effect it was taken for
+    struct FDueEffect
+    {
+        int32 Index = INDEX_NONE;
+        uint32 Sequence = 0;
+        double TickTime = 0.0;
+    };
+
+    int64 GetSlotForTime(double Time) const { return FMath::FloorToInt64(Time / SlotDuration); }
+
+    bool IsSameEffect(int32 EffectIndex, uint32 Sequence) const { return Effects.IsAllocated(EffectIndex) && Effects[EffectIndex].Sequence == Sequence; }
+
+    // Put an effect's next tick into the wheel. False if it has no ticks left
+    bool InsertIntoWheel(int32 EffectIndex);
+
+    void RemoveEffect(int32 EffectIndex);
+
+    // Width of a wheel slot in seconds. Ticks still fire at their exact time, this only sets how finely they are bucketed
+    static constexpr double SlotDuration = 0.05;
+
+    // Slots in the wheel; effects further out than one lap wait in their slot for the lap they are due in
+    static constexpr int32 NumSlots = 256;
+
+    TStaticArray<TArray<int32>, NumSlots> Wheel;
+
+    TSparseArray<FPeriodicEffect> Effects;
+
+    // Target ASC -> its effects, for refreshes and cancels
+    TMap<TWeakObjectPtr<const UAbilitySystemComponent>, TArray<int32, TInlineAllocator<4>>> TargetEffects;
+
+    // First slot not fully processed yet
+    int64 CurrentSlot = 0;
+
+    uint32 NextSequence = 0;
+
+    int32 TicksLastFrame = 0;
+    int64 TotalTicks = 0;
+};
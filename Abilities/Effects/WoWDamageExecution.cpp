@@ -0,0 +1,107 @@
+// File: WoWDamageExecution.cpp
+#include "WoWDamageExecution.h"
+#include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "../../Attributes/WoWAttributeSet.h"
+#include "../../WoWGameplayTags.h"
+
+namespace
+{
+    struct FWoWDamageStatics
+    {
+        FGameplayEffectAttributeCaptureDefinition SourceCritChanceDef;
+        FGameplayEffectAttributeCaptureDefinition SourceVersatilityDef;
+        FGameplayEffectAttributeCaptureDefinition TargetArmorDef;
+        FGameplayEffectAttributeCaptureDefinition TargetVersatilityDef;
+        FGameplayEffectAttributeCaptureDefinition TargetHealthDef;
+
+        FWoWDamageStatics()
+            : SourceCritChanceDef(UWoWAttributeSet::GetCriticalStrikeChanceAttribute(), EGameplayEffectAttributeCaptureSource::Source, true)
+            , SourceVersatilityDef(UWoWAttributeSet::GetVersatilityRatingAttribute(), EGameplayEffectAttributeCaptureSource::Source, true)
+            , TargetArmorDef(UWoWAttributeSet::GetArmorAttribute(), EGameplayEffectAttributeCaptureSource::Target, false)
+            , TargetVersatilityDef(UWoWAttributeSet::GetVersatilityRatingAttribute(), EGameplayEffectAttributeCaptureSource::Target, false)
+            , TargetHealthDef(UWoWAttributeSet::GetHealthAttribute(), EGameplayEffectAttributeCaptureSource::Target, false)
+        {
+        }
+    };
+
+    const FWoWDamageStatics& DamageStatics()
+    {
+        static const FWoWDamageStatics Statics;
+        return Statics;
+    }
+}
+
+UWoWDamageExecution::UWoWDamageExecution()
+{
+    ArmorConstant = 400.0f;
+    MaxArmorMitigation = 0.75f;
+    CritMultiplier = 2.0f;
+    VersatilityRatingPerPercent = 40.0f;
+
+    RelevantAttributesToCapture.Add(DamageStatics().SourceCritChanceDef);
+    RelevantAttributesToCapture.Add(DamageStatics().SourceVersatilityDef);
+    RelevantAttributesToCapture.Add(DamageStatics().TargetArmorDef);
+    RelevantAttributesToCapture.Add(DamageStatics().TargetVersatilityDef);
+    RelevantAttributesToCapture.Add(DamageStatics().TargetHealthDef);
+}
+
+void UWoWDamageExecution::Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const
+{
+    const FGameplayEffectSpec& Spec = ExecutionParams.GetOwningSpec();
+
+    // Callers pass damage negative since it comes off health; work on the amount
+    float Damage = FMath::Abs(Spec.GetSetByCallerMagnitude(WoWGameplayTags::Data_Damage, false));
+    if (Damage <= 0.0f)
+    {
+        return;
+    }
+
+    FAggregatorEvaluateParameters EvaluationParameters;
+    EvaluationParameters.SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
+    EvaluationParameters.TargetTags = Spec.CapturedTargetTags.GetAggregatedTags();
+
+    float CritChance = 0.0f;
+    float SourceVersatility = 0.0f;
+    float TargetArmor = 0.0f;
+    float TargetVersatility = 0.0f;
+    float TargetHealth = 0.0f;
+    ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().SourceCritChanceDef, EvaluationParameters, CritChance);
+    ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().SourceVersatilityDef, EvaluationParameters, SourceVersatility);
+    ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().TargetArmorDef, EvaluationParameters, TargetArmor);
+    ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().TargetVersatilityDef, EvaluationParameters, TargetVersatility);
+    ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().TargetHealthDef, EvaluationParameters, TargetHealth);
+
+    // Crit chance is a percentage
+    const bool bCriticalHit = FMath::FRand() * 100.0f < CritChance;
+    if (bCriticalHit)
+    {
+        Damage *= CritMultiplier;
+    }
+
+    // Versatility: the source's raises damage done, the target's lowers damage taken at half the rate
+    if (VersatilityRatingPerPercent > 0.0f)
+    {
+        Damage *= 1.0f + FMath::Max(SourceVersatility, 0.0f) / VersatilityRatingPerPercent * 0.01f;
+        Damage *= 1.0f - FMath::Min(FMath::Max(TargetVersatility, 0.0f) / VersatilityRatingPerPercent * 0.005f, 1.0f);
+    }
+
+    // Armor
+    TargetArmor = FMath::Max(TargetArmor, 0.0f);
+    if (TargetArmor > 0.0f)
+    {
+        const float Mitigation = FMath::Min(TargetArmor / (TargetArmor + ArmorConstant), MaxArmorMitigation);
+        Damage *= 1.0f - Mitigation;
+    }
+
+    // Never take more than the target has left, so Health needs no fixup afterwards
+    Damage = FMath::Clamp(Damage, 0.0f, FMath::Max(TargetHealth, 0.0f));
+    if (Damage <= 0.0f)
+    {
+        return;
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("WoWDamageExecution: %.1f damage%s (armor %.0f)"), Damage, bCriticalHit ? TEXT(" (critical)") : TEXT(""), TargetArmor);
+
+    OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(UWoWAttributeSet::GetHealthAttribute(), EGameplayModOp::Additive, -Damage));
+}
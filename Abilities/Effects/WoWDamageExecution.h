@@ -0,0 +1,36 @@
+// File: WoWDamageExecution.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffectExecutionCalculation.h"
+#include "WoWDamageExecution.generated.h"
+
+// Resolves one damage event in a single pass: the SetByCaller Data.Damage amount is rolled for crit,
+// scaled by the source's versatility, reduced by the target's armor and versatility, clamped to the
+// target's remaining health and written to Health. Source and target attributes are captured once per execution
+UCLASS()
+class MYPROJECT5_API UWoWDamageExecution : public UGameplayEffectExecutionCalculation
+{
+    GENERATED_BODY()
+
+public:
+    UWoWDamageExecution();
+
+    virtual void Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const override;
+
+protected:
+    // Armor mitigation is Armor / (Armor + ArmorConstant)
+    UPROPERTY(EditDefaultsOnly, Category = "Damage")
+    float ArmorConstant;
+
+    // Most damage armor can remove (0-1)
+    UPROPERTY(EditDefaultsOnly, Category = "Damage")
+    float MaxArmorMitigation;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Damage")
+    float CritMultiplier;
+
+    // Versatility rating for 1% more damage done; damage taken is reduced by half that
+    UPROPERTY(EditDefaultsOnly, Category = "Damage")
+    float VersatilityRatingPerPercent;
+};
@@ -3,10 +3,14 @@
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
 #include "../Components/TargetingComponent.h"
+#include "../Components/CombatStateComponent.h"
 #include "../Character/WoWCharacterBase.h"
 #include "../Character/WoWEnemyCharacter.h"
 #include "../Attributes/WoWAttributeSet.h"
 #include "GameplayEffectTypes.h"
+#include "Effects/CombatQueueSubsystem.h"
+#include "Effects/GE_Damage.h"
+#include "../WoWGameplayTags.h"
 
 UWoWAutoAttackAbility::UWoWAutoAttackAbility()
 {
@@ -16,10 +20,11 @@ UWoWAutoAttackAbility::UWoWAutoAttackAbility()
     AttackRange = 200.0f;
     WeaponBaseSpeed = 10.0f;  // Base weapon speed is 10 seconds (for 1 agility)
     MinAttackSpeed = 1.5f;    // Minimum attack speed with maximum haste
+    DamageEffect = UGE_Damage::StaticClass();
     
     // Set tags
-    AbilityTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Attack.Melee")));
-    ActivationOwnedTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Attack.Melee")));
+    AbilityTags.AddTag(WoWGameplayTags::Ability_Attack_Melee);
+    ActivationOwnedTags.AddTag(WoWGameplayTags::Ability_Attack_Melee);
 }
 
 void UWoWAutoAttackAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, 
@@ -46,10 +51,14 @@ void UWoWAutoAttackAbility::ActivateAbility(const FGameplayAbilitySpecHandle Han
     
     // Check if auto-attack is already active
     UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
-    FGameplayTag AutoAttackTag = FGameplayTag::RequestGameplayTag(FName("Ability.AutoAttack.Active"));
-    
-    // If we already have the tag, we're toggling OFF
-    if (ASC && ASC->HasMatchingGameplayTag(AutoAttackTag))
+    const FGameplayTag AutoAttackTag = WoWGameplayTags::Ability_AutoAttack_Active;
+    
+    // If we already have the tag, we're toggling OFF. The combat state mirrors the tag as one bit
+    const UCombatStateComponent* CombatState = UCombatStateComponent::FindForActor(AvatarActor);
+    const bool bAutoAttackActive = CombatState ? 
+        CombatState->HasAnyState(ECombatStateFlags::AutoAttacking) : 
+        (ASC && ASC->HasMatchingGameplayTag(AutoAttackTag));
+    if (ASC && bAutoAttackActive)
     {
         // Stop auto-attack
         GetWorld()->GetTimerManager().ClearTimer(AutoAttackTimerHandle);
@@ -187,24 +196,10 @@ void UWoWAutoAttackAbility::PerformAutoAttack()
             // Base weapon damage
             float BaseWeaponDamage = 5.0f + (AttributeSet->GetStrength() * 0.5f);
             
-            // Calculate actual damage
+            // Calculate actual damage; crit, armor and versatility are resolved by the damage execution
             DamageAmount = BaseWeaponDamage + (AttackPower / 14.0f);
             
-            // Check for critical strike
-            float CritChance = AttributeSet->GetCriticalStrikeChance();
-            bool IsCriticalHit = (FMath::RandRange(0.0f, 100.0f) <= CritChance);
-            
-            if (IsCriticalHit)
-            {
-                DamageAmount *= 2.0f;
-                
-                if (GEngine)
-                {
-                    GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, 
-                        FString::Printf(TEXT("Critical Hit! %.0f damage"), DamageAmount));
-                }
-            }
-            else if (GEngine)
+            if (GEngine)
             {
                 GEngine->AddOnScreenDebugMessage(-1, 1.0f, FColor::White, 
                     FString::Printf(TEXT("[%d] Hit for %.0f damage"), ThisAttackNumber, DamageAmount));
@@ -268,23 +263,24 @@ void UWoWAutoAttackAbility::ApplyDamageToTarget(AActor* TargetActor, float Damag
     FGameplayEffectContextHandle EffectContext = GetAbilitySystemComponentFromActorInfo()->MakeEffectContext();
     EffectContext.AddSourceObject(GetAvatarActorFromActorInfo());
     
-    // Create effect spec
-    FGameplayEffectSpecHandle SpecHandle = GetAbilitySystemComponentFromActorInfo()->MakeOutgoingSpec(
-        DamageEffect, 1, EffectContext);
+    // Resolve the SetByCaller tag once instead of by name on every swing
+    const FGameplayTag DamageTag = WoWGameplayTags::Data_Damage;
+    
+    // Clone the cached spec for this weapon effect and patch in this swing's context and damage
+    FGameplayEffectSpecHandle SpecHandle = DamageSpecCache.MakeSpec(
+        INDEX_NONE, DamageEffect.GetDefaultObject(), 1.0f, EffectContext, DamageTag, -DamageAmount);
     
     if (SpecHandle.IsValid())
     {
-        // Set damage value using "Data.Damage" tag
-        FGameplayTag DamageTag = FGameplayTag::RequestGameplayTag(FName("Data.Damage"));
-        SpecHandle.Data->SetSetByCallerMagnitude(DamageTag, -DamageAmount);
-        
         UE_LOG(LogTemp, Warning, TEXT("Damage Application #%d applying effect to target"), ThisDamageID);
         
-        // Apply effect to target and capture result
-        FActiveGameplayEffectHandle ActiveHandle = GetAbilitySystemComponentFromActorInfo()->ApplyGameplayEffectSpecToTarget(
-            *SpecHandle.Data.Get(), TargetASC);
-            
-        if (ActiveHandle.IsValid())
+        // Swings landing in the same frame are applied together by the combat queue
+        UCombatQueueSubsystem* CombatQueue = UCombatQueueSubsystem::Get(TargetActor);
+        if (CombatQueue && CombatQueue->EnqueueSpec(TargetASC, SpecHandle, DamageTag))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Damage Application #%d QUEUED"), ThisDamageID);
+        }
+        else if (GetAbilitySystemComponentFromActorInfo()->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), TargetASC).IsValid())
         {
             UE_LOG(LogTemp, Warning, TEXT("Damage Application #%d SUCCESS"), ThisDamageID);
         }
@@ -317,7 +313,7 @@ void UWoWAutoAttackAbility::EndAbility(const FGameplayAbilitySpecHandle Handle,
     UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
     if (ASC)
     {
-        ASC->RemoveLooseGameplayTag(FGameplayTag::RequestGameplayTag(FName("Ability.AutoAttack.Active")));
+        ASC->RemoveLooseGameplayTag(WoWGameplayTags::Ability_AutoAttack_Active);
     }
     
     // Find and update targeting component
@@ -379,5 +375,5 @@ bool UWoWAutoAttackAbility::IsAutoAttackActive(UAbilitySystemComponent* ASC)
         return false;
     }
     
-    return ASC->HasMatchingGameplayTag(FGameplayTag::RequestGameplayTag(FName("Ability.AutoAttack.Active")));
+    return ASC->HasMatchingGameplayTag(WoWGameplayTags::Ability_AutoAttack_Active);
 }
\ No newline at end of file
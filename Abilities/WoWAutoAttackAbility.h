@@ -3,6 +3,7 @@
 
 #include "CoreMinimal.h"
 #include "Abilities/GameplayAbility.h"
+#include "Effects/EffectSpecCache.h"
 #include "WoWAutoAttackAbility.generated.h"
 
 UCLASS()
@@ -45,6 +46,9 @@ float MinAttackSpeed;
     // Timer handle for continuous auto-attack
     FTimerHandle AutoAttackTimerHandle;
     
+    // Damage spec template for this actor's swings (ability is instanced per actor)
+    FEffectSpecCache DamageSpecCache;
+    
     // Apply damage to target
     void ApplyDamageToTarget(AActor* TargetActor, float DamageAmount);
     
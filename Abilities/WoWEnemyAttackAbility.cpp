@@ -3,12 +3,15 @@
 #include "GameplayEffectTypes.h"
 #include "AbilitySystemGlobals.h"
 #include "GameFramework/Character.h"
-#include "Kismet/GameplayStatics.h"
 #include "../Character/WoWEnemyCharacter.h"
 #include "../Character/WoWPlayerCharacter.h"
+#include "../Character/CombatantGridSubsystem.h"
+#include "Effects/CombatQueueSubsystem.h"
+#include "Effects/GE_Damage.h"
 #include "../States/WoWPlayerState.h"
 #include "../AI/WoWEnemyController.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "../WoWGameplayTags.h"
 
 UWoWEnemyAttackAbility::UWoWEnemyAttackAbility()
 {
@@ -17,6 +20,7 @@ UWoWEnemyAttackAbility::UWoWEnemyAttackAbility()
     DamageCoefficient = 1.0f;
     WeaponBaseSpeed = 10.0f;  // Base weapon speed is 10 seconds (for 1 agility)
     MinAttackSpeed = 1.5f;    // Minimum attack speed with maximum haste
+    DamageEffect = UGE_Damage::StaticClass();
     
     // Set instant cast policy
     InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
@@ -68,23 +72,10 @@ void UWoWEnemyAttackAbility::ActivateAbility(const FGameplayAbilitySpecHandle Ha
     {
         UE_LOG(LogTemp, Warning, TEXT("No target from blackboard, searching for nearest player"));
         
-        // Find closest player character in range
-        TArray<AActor*> FoundActors;
-        UGameplayStatics::GetAllActorsOfClass(GetWorld(), ACharacter::StaticClass(), FoundActors);
-        
-        float ClosestDistance = AttackRange;
-        for (AActor* Actor : FoundActors)
+        // Find closest player character in range through the combatant grid
+        if (UCombatantGridSubsystem* CombatantGrid = UCombatantGridSubsystem::Get(SourceActor))
         {
-            APawn* ActorAsPawn = Cast<APawn>(Actor);
-            if (Actor != SourceActor && ActorAsPawn && ActorAsPawn->IsPlayerControlled())
-            {
-                float Distance = FVector::Distance(SourceActor->GetActorLocation(), Actor->GetActorLocation());
-                if (Distance <= ClosestDistance)
-                {
-                    ClosestDistance = Distance;
-                    TargetActor = Actor;
-                }
-            }
+            TargetActor = CombatantGrid->FindNearest(SourceActor->GetActorLocation(), AttackRange, ECombatFaction::Player, SourceActor);
         }
         
         if (TargetActor)
@@ -114,7 +105,7 @@ void UWoWEnemyAttackAbility::ActivateAbility(const FGameplayAbilitySpecHandle Ha
         if (CooldownDuration > 0.0f)
         {
             FGameplayTagContainer CooldownTags;
-            CooldownTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Ability.Attack.Melee")));
+            CooldownTags.AddTag(WoWGameplayTags::Ability_Attack_Melee);
             
             // Just call the base ApplyCooldown method
             ApplyCooldown(Handle, ActorInfo, ActivationInfo);
@@ -205,35 +196,25 @@ void UWoWEnemyAttackAbility::ApplyDamageToTarget(const FGameplayAbilitySpecHandl
     FGameplayEffectContextHandle EffectContext = ActorInfo->AbilitySystemComponent->MakeEffectContext();
     EffectContext.AddSourceObject(ActorInfo->AvatarActor.Get());
     
-    // Create the effect spec
-    FGameplayEffectSpecHandle SpecHandle = ActorInfo->AbilitySystemComponent->MakeOutgoingSpec(DamageEffect, 1, EffectContext);
+    // Resolve the SetByCaller tag once instead of by name on every swing
+    const FGameplayTag DamageTag = WoWGameplayTags::Data_Damage;
+    
+    // Clone the cached spec and patch in this swing's context; damage is negative since we're reducing health
+    FGameplayEffectSpecHandle SpecHandle = DamageSpecCache.MakeSpec(
+        INDEX_NONE, DamageEffect.GetDefaultObject(), 1.0f, EffectContext, DamageTag, -DamageAmount);
     
     if (SpecHandle.IsValid())
     {
         UE_LOG(LogTemp, Warning, TEXT("Created valid GameplayEffectSpec"));
+        UE_LOG(LogTemp, Warning, TEXT("Set damage magnitude to %.2f"), -DamageAmount);
         
-        // Set the damage value using set by caller
-        FGameplayTag DamageTag = FGameplayTag::RequestGameplayTag(FName("Data.Damage"));
-        
-        // Debug: Check if the tag exists
-        if (DamageTag.IsValid())
+        // Hits landing in the same frame are applied together by the combat queue
+        UCombatQueueSubsystem* CombatQueue = UCombatQueueSubsystem::Get(TargetActor);
+        if (CombatQueue && CombatQueue->EnqueueSpec(TargetASC, SpecHandle, DamageTag))
         {
-            UE_LOG(LogTemp, Warning, TEXT("Data.Damage tag is valid"));
+            // Applied with the rest of the frame's hits when the queue flushes
         }
-        else
-        {
-            UE_LOG(LogTemp, Error, TEXT("Data.Damage tag is NOT valid! Create this tag in project settings."));
-        }
-        
-        // Make damage negative since we're reducing health
-        SpecHandle.Data->SetSetByCallerMagnitude(DamageTag, -DamageAmount);
-        UE_LOG(LogTemp, Warning, TEXT("Set damage magnitude to %.2f"), -DamageAmount);
-        
-        // Apply the effect to the target
-        FActiveGameplayEffectHandle AppliedEffect = ActorInfo->AbilitySystemComponent->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), TargetASC);
-        
-        // Check if effect was applied successfully
-        if (AppliedEffect.IsValid())
+        else if (ActorInfo->AbilitySystemComponent->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), TargetASC).IsValid())
         {
             UE_LOG(LogTemp, Warning, TEXT("Successfully applied damage effect"));
             
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Abilities/GameplayAbility.h"
+#include "Effects/EffectSpecCache.h"
 #include "WoWEnemyAttackAbility.generated.h"
 
 UCLASS()
@@ -41,6 +42,9 @@ protected:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attack")
     float CooldownDuration;
     
+    // Damage spec template for this actor's swings (ability is instanced per actor)
+    FEffectSpecCache DamageSpecCache;
+    
     // Apply damage to the target
     void ApplyDamageToTarget(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, AActor* TargetActor, float DamageAmount);
 };
\ No newline at end of file
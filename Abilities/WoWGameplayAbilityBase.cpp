@@ -9,12 +9,14 @@
 #include "../Character/WoWCharacterBase.h"
 #include "../Character/WoWPlayerCharacter.h"
 #include "../Components/TargetingComponent.h"
+#include "../Components/CombatStateComponent.h"
 #include "../Attributes/WoWAttributeSet.h" // Critical include!
+#include "../WoWGameplayTags.h"
 
 UWoWGameplayAbilityBase::UWoWGameplayAbilityBase()
 {
     AbilityID = 0;
-    bAbilityDataLoaded = false;
+    AbilityDataAsset = nullptr;
     
     // Find the cooldown effect class - now looking for the BP version
     static ConstructorHelpers::FClassFinder<UGameplayEffect> CooldownEffectFinder(TEXT("/Game/Abilities/Effects/GE_AbilityCooldown_BP"));
@@ -64,41 +66,82 @@ UWoWGameplayAbilityBase::UWoWGameplayAbilityBase()
 
 bool UWoWGameplayAbilityBase::GetAbilityData(FAbilityTableRow& OutAbilityData) const
 {
-    if (bAbilityDataLoaded)
+    const FAbilityRuntimeDefinition* Definition = GetAbilityDefinition();
+    if (!Definition)
     {
-        return true;
+        return false;
     }
     
-    // If not already loaded, try to load it
+    OutAbilityData = *Definition->Row;
+    return true;
+}
+
+const FAbilityRuntimeDefinition* UWoWGameplayAbilityBase::GetAbilityDefinition() const
+{
+    // While active, stick to the definition the activation started with even if the data was rebalanced since
+    return ActiveDefinition.IsValid() ? ActiveDefinition.Get() : AbilityDefinition.Get();
+}
+
+void UWoWGameplayAbilityBase::InitializeFromAbilityData(int32 InAbilityID)
+{
+    AbilityID = InAbilityID;
+    AbilityDefinition.Reset();
+    
+    ResolveAbilityDefinition(GetCurrentActorInfo());
+}
+
+void UWoWGameplayAbilityBase::OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
+{
+    Super::OnGiveAbility(ActorInfo, Spec);
+    
+    ResolveAbilityDefinition(ActorInfo, Spec.SourceObject.Get());
+}
+
+void UWoWGameplayAbilityBase::OnRemoveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
+{
     if (AbilityDataAsset)
     {
-        bool bFound = AbilityDataAsset->GetAbilityDataByID(AbilityID, OutAbilityData);
-        if (!bFound)
+        AbilityDataAsset->OnSnapshotChanged.Remove(AbilityDataChangedHandle);
+    }
+    AbilityDataChangedHandle.Reset();
+    
+    Super::OnRemoveAbility(ActorInfo, Spec);
+}
+
+void UWoWGameplayAbilityBase::ResolveAbilityDefinition(const FGameplayAbilityActorInfo* ActorInfo, const UObject* SourceObject)
+{
+    if (!AbilityDataAsset)
+    {
+        const AWoWCharacterBase* Character = ActorInfo ? Cast<AWoWCharacterBase>(ActorInfo->AvatarActor.Get()) : nullptr;
+        if (!Character)
         {
-            // NEW: Debug the data table contents
-            TArray<FAbilityTableRow*> AllRows;
-            AbilityDataAsset->AbilityDataTable->GetAllRows(TEXT("GetAbilityData"), AllRows);
-            
-            UE_LOG(LogTemp, Warning, TEXT("Available ability IDs in data table:"));
-            for (FAbilityTableRow* Row : AllRows)
-            {
-                UE_LOG(LogTemp, Warning, TEXT("  ID: %d, Name: %s"), Row->AbilityID, *Row->DisplayName);
-            }
+            Character = Cast<AWoWCharacterBase>(SourceObject);
         }
-        return bFound;
+        
+        AbilityDataAsset = Character ? Character->GetAbilityDataAsset() : nullptr;
     }
     
-    return false;
+    if (!AbilityDataAsset)
+    {
+        return;
+    }
+    
+    // Only instances follow hot swaps; the CDO never runs an activation
+    if (!AbilityDataChangedHandle.IsValid() && !HasAnyFlags(RF_ClassDefaultObject))
+    {
+        AbilityDataChangedHandle = AbilityDataAsset->OnSnapshotChanged.AddUObject(this, &UWoWGameplayAbilityBase::OnAbilityDataSnapshotChanged);
+    }
+    
+    AbilityDefinition = AbilityDataAsset->FindAbilityDefinitionByID(AbilityID);
+    if (!AbilityDefinition.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Ability ID %d not found in %s"), AbilityID, *AbilityDataAsset->GetName());
+    }
 }
 
-void UWoWGameplayAbilityBase::InitializeFromAbilityData(int32 InAbilityID)
+void UWoWGameplayAbilityBase::OnAbilityDataSnapshotChanged(const FAbilityDataSnapshotPtr& NewSnapshot)
 {
-    AbilityID = InAbilityID;
-    bAbilityDataLoaded = false;
-    
-    // Try to load the ability data immediately
-    FAbilityTableRow AbilityData;
-    GetAbilityData(AbilityData);
+    AbilityDefinition = NewSnapshot.IsValid() ? NewSnapshot->FindDefinitionByID(AbilityID) : FAbilityDefinitionPtr();
 }
 
 UEffectApplicationComponent* UWoWGameplayAbilityBase::GetEffectComponent() const
@@ -153,17 +196,17 @@ void UWoWGameplayAbilityBase::EndAbility(const FGameplayAbilitySpecHandle Handle
     // Only apply cooldown if the ability wasn't cancelled and wasn't interrupted
     if (!bSkipCooldown && ActorInfo && ActorInfo->AbilitySystemComponent.IsValid())
     {
-        // Get ability data for cooldown info
-        FAbilityTableRow AbilityData;
-        if (GetAbilityData(AbilityData) && AbilityData.Cooldown > 0.0f)
+        // Cooldown info comes from the definition the activation ran on
+        const FAbilityRuntimeDefinition* Definition = GetAbilityDefinition();
+        if (Definition && Definition->HasFlag(EAbilityDefinitionFlags::HasCooldown))
         {
             UE_LOG(LogTemp, Warning, TEXT("Applying cooldown for ability %d (%s)"), 
-                AbilityID, *AbilityData.DisplayName);
+                AbilityID, *Definition->Row->DisplayName);
             
             // Get the cooldown tag
-            FGameplayTag CooldownTag = AbilityData.CooldownTag.IsValid() ?
-                AbilityData.CooldownTag :
-                FGameplayTag::RequestGameplayTag(FName("Ability.Cooldown.Spell.Fireball"), true);
+            FGameplayTag CooldownTag = Definition->CooldownTag.IsValid() ?
+                Definition->CooldownTag :
+                FGameplayTag(WoWGameplayTags::Ability_Cooldown_Spell_Fireball);
             
             if (CooldownTag.IsValid())
             {
@@ -180,7 +223,7 @@ void UWoWGameplayAbilityBase::EndAbility(const FGameplayAbilitySpecHandle Handle
                 {
                     GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Red,
                         FString::Printf(TEXT("COOLDOWN ADDED: %s (%.1fs)"), 
-                        *CooldownTag.ToString(), AbilityData.Cooldown));
+                        *CooldownTag.ToString(), Definition->Cooldown));
                 }
                 
                 // Set up a timer to remove the tag
@@ -234,7 +277,7 @@ void UWoWGameplayAbilityBase::EndAbility(const FGameplayAbilitySpecHandle Handle
                     World->GetTimerManager().SetTimer(
                         TimerHandle, 
                         TimerDelegate, 
-                        AbilityData.Cooldown, 
+                        Definition->Cooldown, 
                         false
                     );
                 }
@@ -257,17 +300,17 @@ void UWoWGameplayAbilityBase::EndAbility(const FGameplayAbilitySpecHandle Handle
                         UE_LOG(LogTemp, Warning, TEXT("Created valid cooldown effect spec"));
                         
                         // CRITICAL FIX: Directly override the Duration property in the spec
-                        SpecHandle.Data->Duration = AbilityData.Cooldown;
+                        SpecHandle.Data->Duration = Definition->Cooldown;
                         
                         // Set the cooldown duration via SetByCaller as well
-                        FGameplayTag DurationTag = FGameplayTag::RequestGameplayTag(FName("Data.Cooldown"));
-                        SpecHandle.Data->SetSetByCallerMagnitude(DurationTag, AbilityData.Cooldown);
+                        FGameplayTag DurationTag = WoWGameplayTags::Data_Cooldown;
+                        SpecHandle.Data->SetSetByCallerMagnitude(DurationTag, Definition->Cooldown);
                         
                         UE_LOG(LogTemp, Warning, TEXT("Set cooldown duration to %.1f using tag: %s"), 
-                            AbilityData.Cooldown, *DurationTag.ToString());
+                            Definition->Cooldown, *DurationTag.ToString());
                         
                         // NEW: Create and add ability ID tag for SetByCaller
-                        FGameplayTag AbilityIDTag = FGameplayTag::RequestGameplayTag(FName("Data.AbilityID"), true);
+                        FGameplayTag AbilityIDTag = WoWGameplayTags::Data_AbilityID;
                         SpecHandle.Data->SetSetByCallerMagnitude(AbilityIDTag, static_cast<float>(AbilityID));
                         
                         // Print debug information to screen and log
@@ -322,41 +365,30 @@ void UWoWGameplayAbilityBase::EndAbility(const FGameplayAbilitySpecHandle Handle
     
     // Call the parent class implementation
     Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
+    
+    // Release the activation definition, the next activation picks up whatever data is current then
+    ActiveDefinition.Reset();
     UE_LOG(LogTemp, Warning, TEXT("===== END ABILITY COMPLETE ====="));
 }
 
 FGameplayTag UWoWGameplayAbilityBase::GetCooldownTag() const
 {
-    // Get ability data
-    FAbilityTableRow AbilityData;
-    if (GetAbilityData(AbilityData) && AbilityData.CooldownTag.IsValid())
+    const FAbilityRuntimeDefinition* Definition = GetAbilityDefinition();
+    if (Definition && Definition->CooldownTag.IsValid())
     {
         UE_LOG(LogTemp, Warning, TEXT("Using ability-specific cooldown tag: %s"), 
-            *AbilityData.CooldownTag.ToString());
-        return AbilityData.CooldownTag;
+            *Definition->CooldownTag.ToString());
+        return Definition->CooldownTag;
     }
     
-    // Create a fallback tag if none was provided
-    FName TagName = FName(*FString::Printf(TEXT("Ability.Cooldown.ID.%d"), AbilityID));
-    
-    // Use the standard way to request a gameplay tag
-    FGameplayTag CooldownTag = FGameplayTag::RequestGameplayTag(TagName, false);
+    // Fall back to the per-ability ID tag registered when the table loaded
+    FGameplayTag CooldownTag = Definition ? Definition->IDCooldownTag : FAbilityCooldownTags::Find(AbilityID);
     
     if (!CooldownTag.IsValid())
     {
-        // If the tag doesn't exist yet, try to create it
-        CooldownTag = FGameplayTag::RequestGameplayTag(TagName, true);
-        
-        if (CooldownTag.IsValid())
-        {
-            UE_LOG(LogTemp, Warning, TEXT("Created new cooldown tag: %s"), *CooldownTag.ToString());
-        }
-        else
-        {
-            // Fall back to a more generic tag
-            CooldownTag = FGameplayTag::RequestGameplayTag(FName("Ability.Cooldown"), false);
-            UE_LOG(LogTemp, Warning, TEXT("Using generic cooldown tag: %s"), *CooldownTag.ToString());
-        }
+        // Fall back to a more generic tag
+        CooldownTag = WoWGameplayTags::Ability_Cooldown;
+        UE_LOG(LogTemp, Warning, TEXT("Using generic cooldown tag: %s"), *CooldownTag.ToString());
     }
     
     return CooldownTag;
@@ -386,8 +418,32 @@ bool UWoWGameplayAbilityBase::CanActivateAbility(const FGameplayAbilitySpecHandl
     
     UE_LOG(LogTemp, Warning, TEXT("Super::CanActivateAbility returned true"));
     
-    // Check if ability is on cooldown
-    if (ActorInfo && ActorInfo->AbilitySystemComponent.IsValid())
+    // Dead or stunned characters can't start anything; one mask test on the avatar's combat state
+    const UCombatStateComponent* CombatState = ActorInfo ? UCombatStateComponent::FindForActor(ActorInfo->AvatarActor.Get()) : nullptr;
+    if (CombatState && CombatState->IsIncapacitated())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Ability %d blocked, owner is dead or stunned"), AbilityID);
+        return false;
+    }
+    
+    // Check if ability is on cooldown. Cooldown tags all live under Ability.Cooldown, and any of them sets the
+    // combat state bit, so characters need one mask test instead of a lookup per tag
+    if (CombatState)
+    {
+        if (CombatState->HasAnyState(ECombatStateFlags::AbilityCooldown))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Ability %d is on cooldown"), AbilityID);
+            
+            if (GEngine)
+            {
+                GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red,
+                    FString::Printf(TEXT("Ability %d on cooldown"), AbilityID));
+            }
+            
+            return false;
+        }
+    }
+    else if (ActorInfo && ActorInfo->AbilitySystemComponent.IsValid())
     {
         // Get all the tags currently on the ASC
         FGameplayTagContainer AllTags;
@@ -399,11 +455,11 @@ bool UWoWGameplayAbilityBase::CanActivateAbility(const FGameplayAbilitySpecHandl
         }
         
         // Get the correct ability data
-        FAbilityTableRow AbilityData;
-        if (GetAbilityData(AbilityData) && AbilityData.CooldownTag.IsValid())
+        const FAbilityRuntimeDefinition* Definition = GetAbilityDefinition();
+        if (Definition && Definition->CooldownTag.IsValid())
         {
             // Use the specific tag from data
-            FGameplayTag CooldownTag = AbilityData.CooldownTag;
+            FGameplayTag CooldownTag = Definition->CooldownTag;
             UE_LOG(LogTemp, Warning, TEXT("Checking for ability-specific cooldown tag: %s"), 
                 *CooldownTag.ToString());
             
@@ -427,9 +483,8 @@ bool UWoWGameplayAbilityBase::CanActivateAbility(const FGameplayAbilitySpecHandl
             }
         }
         
-        // As a backup, also check the generic cooldown tag
-        FGameplayTag GenericCooldownTag = FGameplayTag::RequestGameplayTag(
-            FName(*FString::Printf(TEXT("Ability.Cooldown.ID.%d"), AbilityID)));
+        // As a backup, also check the per-ability ID tag registered when the table loaded
+        FGameplayTag GenericCooldownTag = Definition ? Definition->IDCooldownTag : FAbilityCooldownTags::Find(AbilityID);
             
         if (GenericCooldownTag.IsValid())
         {
@@ -450,8 +505,7 @@ bool UWoWGameplayAbilityBase::CanActivateAbility(const FGameplayAbilitySpecHandl
         }
         
         // As an ultimate fallback, check the base cooldown tag
-        FGameplayTag BaseCooldownTag = FGameplayTag::RequestGameplayTag(FName("Ability.Cooldown"));
-        bool bHasBaseTag = ActorInfo->AbilitySystemComponent->HasMatchingGameplayTag(BaseCooldownTag);
+        bool bHasBaseTag = ActorInfo->AbilitySystemComponent->HasMatchingGameplayTag(WoWGameplayTags::Ability_Cooldown);
         
         if (bHasBaseTag)
         {
@@ -468,20 +522,16 @@ bool UWoWGameplayAbilityBase::CanActivateAbility(const FGameplayAbilitySpecHandl
     }
     
     // Get ability data
-    FAbilityTableRow AbilityData;
-    bool bGotData = GetAbilityData(AbilityData);
+    const FAbilityRuntimeDefinition* Definition = GetAbilityDefinition();
     
     // If no data, fall back to default behavior
-    if (!bGotData)
+    if (!Definition)
     {
         return true;
     }
     
     // Check if this ability requires a target
-    bool bRequiresTarget = (AbilityData.AbilityType == EAbilityType::Target || 
-                           AbilityData.AbilityType == EAbilityType::Cast);
-    
-    if (bRequiresTarget)
+    if (Definition->HasFlag(EAbilityDefinitionFlags::RequiresTarget))
     {
         // Validate target existence
         if (!ActorInfo || !ActorInfo->AvatarActor.IsValid())
@@ -513,7 +563,7 @@ bool UWoWGameplayAbilityBase::CanActivateAbility(const FGameplayAbilitySpecHandl
         if (TargetActor)
         {
             AWoWPlayerCharacter* PlayerTarget = Cast<AWoWPlayerCharacter>(TargetActor);
-            if (PlayerTarget && AbilityData.AbilityType != EAbilityType::Friendly)
+            if (PlayerTarget && !Definition->HasFlag(EAbilityDefinitionFlags::Friendly))
             {
                 if (GEngine)
                 {
@@ -543,36 +593,33 @@ void UWoWGameplayAbilityBase::ActivateAbility(const FGameplayAbilitySpecHandle H
     CurrentActorInfo = ActorInfo;
     CurrentActivationInfo = ActivationInfo;
     
-    // Try to get AbilityDataAsset if not already set
-    if (!AbilityDataAsset && ActorInfo && ActorInfo->AvatarActor.IsValid())
+    // Normally resolved at grant time; covers abilities whose data asset was assigned later
+    if (!AbilityDefinition.IsValid())
     {
-        AWoWCharacterBase* Character = Cast<AWoWCharacterBase>(ActorInfo->AvatarActor.Get());
-        if (Character)
-        {
-            AbilityDataAsset = Character->GetAbilityDataAsset();
-        }
+        ResolveAbilityDefinition(ActorInfo);
     }
     
-    // Get ability data
-    FAbilityTableRow AbilityData;
-    bool bGotData = GetAbilityData(AbilityData);
+    // Pin the definition for the whole activation, including any cast time
+    ActiveDefinition = AbilityDefinition;
+    const FAbilityRuntimeDefinition* Definition = ActiveDefinition.Get();
     
-    if (bGotData)
+    if (Definition)
     {
+        const FAbilityTableRow& AbilityData = *Definition->Row;
         UE_LOG(LogTemp, Warning, TEXT("Activating ability: %s (ID: %d)"), *AbilityData.DisplayName, AbilityID);
         
         // Check if this has a cast time
-        if (AbilityData.CastTime > 0.0f)
+        if (Definition->HasFlag(EAbilityDefinitionFlags::HasCastTime))
         {
             UE_LOG(LogTemp, Warning, TEXT("Started casting %s with %.1f second cast time"), 
-                *AbilityData.DisplayName, AbilityData.CastTime);
+                *AbilityData.DisplayName, Definition->CastTime);
             
             // Set up a timer to delay ability execution
             GetWorld()->GetTimerManager().SetTimer(
                 CastTimerHandle,
                 this,
                 &UWoWGameplayAbilityBase::OnCastTimeComplete,
-                AbilityData.CastTime,
+                Definition->CastTime,
                 false
             );
             
@@ -583,16 +630,9 @@ void UWoWGameplayAbilityBase::ActivateAbility(const FGameplayAbilitySpecHandle H
                 UCastingComponent* CastingComp = OwnerActor->FindComponentByClass<UCastingComponent>();
                 if (CastingComp)
                 {
-                    // Check if this ability can be cast while moving
-                    bool bCanCastWhileMoving = false;
+                    const bool bCanCastWhileMoving = Definition->HasFlag(EAbilityDefinitionFlags::CanCastWhileMoving);
                     
-                    // Check ability data for this flag
-                    if (AbilityData.bCanCastWhileMoving)
-                    {
-                        bCanCastWhileMoving = true;
-                    }
-                    
-                    CastingComp->NotifyCastStarted(AbilityData.DisplayName, AbilityData.CastTime, bCanCastWhileMoving);
+                    CastingComp->NotifyCastStarted(AbilityData.DisplayName, Definition->CastTime, bCanCastWhileMoving);
                 }
             }
             
@@ -608,9 +648,9 @@ void UWoWGameplayAbilityBase::ActivateAbility(const FGameplayAbilitySpecHandle H
         UE_LOG(LogTemp, Warning, TEXT("Ability committed successfully"));
         
         // Consume mana if we have data
-        if (bGotData)
+        if (Definition)
         {
-            ConsumeManaCost(AbilityData.ManaCost, ActorInfo);
+            ConsumeManaCost(Definition->ManaCost, ActorInfo);
         }
         
         // Execute the ability
@@ -646,9 +686,7 @@ void UWoWGameplayAbilityBase::ExecuteAbility(const FGameplayAbilitySpecHandle Ha
         return;
     }
     
-    // Get ability data
-    FAbilityTableRow AbilityData;
-    bool bGotData = GetAbilityData(AbilityData);
+    const FAbilityRuntimeDefinition* Definition = GetAbilityDefinition();
     
     // Check if we have a target
     if (TargetingComp->HasValidTarget())
@@ -660,7 +698,7 @@ void UWoWGameplayAbilityBase::ExecuteAbility(const FGameplayAbilitySpecHandle Ha
             ApplyEffectsToTarget(TargetActor, EEffectContainerType::Target);
         }
     }
-    else if (bGotData && AbilityData.SelfEffects.EffectIDs.Num() > 0)
+    else if (Definition && Definition->HasFlag(EAbilityDefinitionFlags::HasSelfEffects))
     {
         // Apply self effects if no target but we have self effects
         ApplyEffectsToTarget(PlayerCharacter, EEffectContainerType::Self);
@@ -703,9 +741,10 @@ void UWoWGameplayAbilityBase::OnCastTimeComplete()
         return;
     }
     
-    FAbilityTableRow AbilityData;
-    if (GetAbilityData(AbilityData))
+    const FAbilityRuntimeDefinition* Definition = GetAbilityDefinition();
+    if (Definition)
     {
+        const FAbilityTableRow& AbilityData = *Definition->Row;
         UE_LOG(LogTemp, Warning, TEXT("Cast completed for ability: %s"), *AbilityData.DisplayName);
         
         // Now that cast is complete, commit the ability and apply effects
@@ -719,7 +758,7 @@ void UWoWGameplayAbilityBase::OnCastTimeComplete()
                 CastingComp->NotifyCastCompleted();
             }
             
-            ConsumeManaCost(AbilityData.ManaCost, CurrentActorInfo);
+            ConsumeManaCost(Definition->ManaCost, CurrentActorInfo);
             ExecuteGameplayEffects(CurrentActorInfo);
             
             // Broadcast cast complete event
@@ -778,8 +817,7 @@ void UWoWGameplayAbilityBase::ExecuteGameplayEffects(const FGameplayAbilityActor
     }
     
     // Get ability data to check ability type
-    FAbilityTableRow AbilityData;
-    bool bGotData = GetAbilityData(AbilityData);
+    const FAbilityRuntimeDefinition* Definition = GetAbilityDefinition();
     
     // Get target through targeting component
     AWoWPlayerCharacter* PlayerCharacter = Cast<AWoWPlayerCharacter>(AvatarActor);
@@ -795,7 +833,7 @@ void UWoWGameplayAbilityBase::ExecuteGameplayEffects(const FGameplayAbilityActor
                 {
                     // Check if target is a player - don't allow targeting players unless it's a friendly spell
                     AWoWPlayerCharacter* PlayerTarget = Cast<AWoWPlayerCharacter>(TargetActor);
-                    if (PlayerTarget && bGotData && AbilityData.AbilityType != EAbilityType::Friendly)
+                    if (PlayerTarget && Definition && !Definition->HasFlag(EAbilityDefinitionFlags::Friendly))
                     {
                         // Can't target other players with non-friendly abilities
                         UE_LOG(LogTemp, Warning, TEXT("Cannot target other players with non-friendly abilities"));
@@ -851,9 +889,7 @@ void UWoWGameplayAbilityBase::ExecuteGameplayEffects(const FGameplayAbilityActor
             else
             {
                 // No valid target - check if ability requires a target
-                if (bGotData && 
-                    (AbilityData.AbilityType == EAbilityType::Target || 
-                     AbilityData.AbilityType == EAbilityType::Cast))
+                if (Definition && Definition->HasFlag(EAbilityDefinitionFlags::RequiresTarget))
                 {
                     UE_LOG(LogTemp, Warning, TEXT("This ability requires a target."));
                     EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, true);
@@ -861,7 +897,7 @@ void UWoWGameplayAbilityBase::ExecuteGameplayEffects(const FGameplayAbilityActor
                 }
                 
                 // For non-targeted abilities, apply self effects if any
-                if (bGotData && AbilityData.SelfEffects.EffectIDs.Num() > 0)
+                if (Definition && Definition->HasFlag(EAbilityDefinitionFlags::HasSelfEffects))
                 {
                     bool Success = ApplyEffectsToTarget(PlayerCharacter, EEffectContainerType::Self);
                     UE_LOG(LogTemp, Warning, TEXT("Apply self effects result: %s"), 
@@ -910,10 +946,9 @@ void UWoWGameplayAbilityBase::CancelAbility(const FGameplayAbilitySpecHandle Han
         }
         
         // Optional: Broadcast cast interrupted event
-        FAbilityTableRow AbilityData;
-        if (GetAbilityData(AbilityData))
+        if (const FAbilityRuntimeDefinition* Definition = GetAbilityDefinition())
         {
-            OnAbilityCastInterrupted.Broadcast(AbilityData);
+            OnAbilityCastInterrupted.Broadcast(*Definition->Row);
         }
     }
     
@@ -931,34 +966,19 @@ bool UWoWGameplayAbilityBase::ApplyEffectsToTarget(AActor* TargetActor, EEffectC
     UE_LOG(LogTemp, Warning, TEXT("Applying effects to target: %s"), *TargetActor->GetName());
     
     // Make sure ability data is loaded
-    FAbilityTableRow AbilityData;
-    if (!GetAbilityData(AbilityData))
+    const FAbilityRuntimeDefinition* Definition = GetAbilityDefinition();
+    if (!Definition)
     {
         UE_LOG(LogTemp, Error, TEXT("ApplyEffectsToTarget: Failed to get ability data"));
         return false;
     }
     
     // Get the effect container based on type
-    const FEffectContainerSpec* EffectContainer = nullptr;
-    switch (ContainerType)
-    {
-        case EEffectContainerType::Self:
-            EffectContainer = &AbilityData.SelfEffects;
-            UE_LOG(LogTemp, Warning, TEXT("Using SelfEffects container"));
-            break;
-            
-        case EEffectContainerType::Target:
-            EffectContainer = &AbilityData.TargetEffects;
-            UE_LOG(LogTemp, Warning, TEXT("Using TargetEffects container with %d effects"), AbilityData.TargetEffects.EffectIDs.Num());
-            break;
-            
-        case EEffectContainerType::Area:
-            EffectContainer = &AbilityData.AreaEffects;
-            UE_LOG(LogTemp, Warning, TEXT("Using AreaEffects container"));
-            break;
-    }
+    const FEffectContainerSpec* EffectContainer = &Definition->GetEffectContainer(ContainerType);
+    UE_LOG(LogTemp, Warning, TEXT("Using %s container with %d effects"), 
+        *UEnum::GetValueAsString(ContainerType), EffectContainer->EffectIDs.Num());
     
-    if (!EffectContainer || EffectContainer->EffectIDs.Num() == 0)
+    if (EffectContainer->EffectIDs.Num() == 0)
     {
         UE_LOG(LogTemp, Error, TEXT("ApplyEffectsToTarget: No effect IDs in container!"));
         return false;
@@ -993,30 +1013,16 @@ int32 UWoWGameplayAbilityBase::ApplyAreaEffects(AActor* CenterActor, float Radiu
     }
     
     // Make sure ability data is loaded
-    FAbilityTableRow AbilityData;
-    if (!GetAbilityData(AbilityData))
+    const FAbilityRuntimeDefinition* Definition = GetAbilityDefinition();
+    if (!Definition)
     {
         return 0;
     }
     
     // Get the effect container based on type
-    const FEffectContainerSpec* EffectContainer = nullptr;
-    switch (ContainerType)
-    {
-        case EEffectContainerType::Self:
-            EffectContainer = &AbilityData.SelfEffects;
-            break;
-            
-        case EEffectContainerType::Target:
-            EffectContainer = &AbilityData.TargetEffects;
-            break;
-            
-        case EEffectContainerType::Area:
-            EffectContainer = &AbilityData.AreaEffects;
-            break;
-    }
+    const FEffectContainerSpec* EffectContainer = &Definition->GetEffectContainer(ContainerType);
     
-    if (!EffectContainer || EffectContainer->EffectIDs.Num() == 0)
+    if (EffectContainer->EffectIDs.Num() == 0)
     {
         return 0;
     }
@@ -1031,7 +1037,7 @@ int32 UWoWGameplayAbilityBase::ApplyAreaEffects(AActor* CenterActor, float Radiu
     // Use radius from ability data if none provided
     if (Radius <= 0.0f && ContainerType == EEffectContainerType::Area)
     {
-        Radius = AbilityData.AreaEffectRadius;
+        Radius = Definition->AreaEffectRadius;
     }
     
     // Apply the area effects
@@ -1040,28 +1046,9 @@ int32 UWoWGameplayAbilityBase::ApplyAreaEffects(AActor* CenterActor, float Radiu
 
 const FEffectContainerSpec& UWoWGameplayAbilityBase::GetEffectContainer(EEffectContainerType ContainerType) const
 {
-    static FEffectContainerSpec EmptyContainer;
-    
-    // Make sure ability data is loaded
-    FAbilityTableRow AbilityData;
-    if (!GetAbilityData(AbilityData))
-    {
-        return EmptyContainer;
-    }
+    static const FEffectContainerSpec EmptyContainer;
     
-    // Return the appropriate container
-    switch (ContainerType)
-    {
-        case EEffectContainerType::Self:
-            return AbilityData.SelfEffects;
-            
-        case EEffectContainerType::Target:
-            return AbilityData.TargetEffects;
-            
-        case EEffectContainerType::Area:
-            return AbilityData.AreaEffects;
-            
-        default:
-            return EmptyContainer;
-    }
-}
\ No newline at end of file
+    // The container lives in the definition's shared row, so the reference stays valid while we hold it
+    const FAbilityRuntimeDefinition* Definition = GetAbilityDefinition();
+    return Definition ? Definition->GetEffectContainer(ContainerType) : EmptyContainer;
+}
@@ -27,6 +27,11 @@ public:
     UFUNCTION(BlueprintPure, Category = "Ability")
     int32 GetAbilityID() const { return AbilityID; }
 
+    // Resolve the runtime definition once, when the ability is granted
+    virtual void OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
+    
+    virtual void OnRemoveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
+    
     // Override to implement ability logic
     virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, 
                                 const FGameplayAbilityActorInfo* ActorInfo, 
@@ -53,6 +58,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Ability")
     bool GetAbilityData(FAbilityTableRow& OutAbilityData) const;
     
+    // The definition this ability runs on: the one pinned at activation while active, otherwise the one
+    // resolved at grant time. Null if the ability ID is not in the table
+    const FAbilityRuntimeDefinition* GetAbilityDefinition() const;
+    
     // Initialize from ability table row ID
     UFUNCTION(BlueprintCallable, Category = "Ability")
     void InitializeFromAbilityData(int32 AbilityID);
@@ -92,18 +101,24 @@ protected:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Cooldown")
     TSubclassOf<UGameplayEffect> CooldownGameplayEffect;
     
-    // Cached ability data
-    UPROPERTY(Transient)
-    FAbilityTableRow CachedAbilityData;
-    
-    // Flag indicating if ability data has been loaded
-    UPROPERTY(Transient)
-    bool bAbilityDataLoaded;
-    
     // Reference to the ability data asset
     UPROPERTY(Transient)
     UAbilityDataAsset* AbilityDataAsset;
     
+    // Definition resolved at grant time, replaced whenever the ability data is hot-swapped
+    FAbilityDefinitionPtr AbilityDefinition;
+    
+    // Definition captured at activation and held until EndAbility, so a live rebalance never changes an in-flight cast
+    FAbilityDefinitionPtr ActiveDefinition;
+    
+    FDelegateHandle AbilityDataChangedHandle;
+    
+    // Find the data asset (from the avatar, or the character that granted us) and look up our definition
+    void ResolveAbilityDefinition(const FGameplayAbilityActorInfo* ActorInfo, const UObject* SourceObject = nullptr);
+    
+    // Pick up the new definition after a hot swap
+    void OnAbilityDataSnapshotChanged(const FAbilityDataSnapshotPtr& NewSnapshot);
+    
     // For cast time handling
     FTimerHandle CastTimerHandle;
     FGameplayAbilitySpecHandle CurrentSpecHandle;
@@ -4,6 +4,7 @@
 #include "GameplayEffectExtension.h"
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemBlueprintLibrary.h"
+#include "../WoWGameplayTags.h"
 
 UWoWAttributeSet::UWoWAttributeSet()
 {
@@ -117,6 +118,56 @@ void UWoWAttributeSet::UpdateDerivedAttributes(UAbilitySystemComponent* AbilityC
     }
 }
 
+const TMap<FName, FGameplayAttribute>& UWoWAttributeSet::GetStatTagAttributeMap()
+{
+    // Built once on first use. Keyed by tag name so it does not depend on the tag manager being ready yet
+    static const TMap<FName, FGameplayAttribute> StatTagMap = []()
+    {
+        TMap<FName, FGameplayAttribute> Map;
+        
+        // Primary attributes
+        Map.Add(TEXT("Attribute.Primary.Strength"), GetStrengthAttribute());
+        Map.Add(TEXT("Attribute.Primary.Agility"), GetAgilityAttribute());
+        Map.Add(TEXT("Attribute.Primary.Intellect"), GetIntellectAttribute());
+        Map.Add(TEXT("Attribute.Primary.Stamina"), GetStaminaAttribute());
+        Map.Add(TEXT("Attribute.Primary.Spirit"), GetSpiritAttribute());
+        
+        // Secondary attributes (ratings also answer to their short names)
+        Map.Add(TEXT("Attribute.Secondary.Armor"), GetArmorAttribute());
+        Map.Add(TEXT("Attribute.Secondary.CriticalStrikeChance"), GetCriticalStrikeChanceAttribute());
+        Map.Add(TEXT("Attribute.Secondary.HasteRating"), GetHasteRatingAttribute());
+        Map.Add(TEXT("Attribute.Secondary.Haste"), GetHasteRatingAttribute());
+        Map.Add(TEXT("Attribute.Secondary.MasteryRating"), GetMasteryRatingAttribute());
+        Map.Add(TEXT("Attribute.Secondary.Mastery"), GetMasteryRatingAttribute());
+        Map.Add(TEXT("Attribute.Secondary.VersatilityRating"), GetVersatilityRatingAttribute());
+        Map.Add(TEXT("Attribute.Secondary.Versatility"), GetVersatilityRatingAttribute());
+        
+        // Vital attributes
+        Map.Add(TEXT("Attribute.Vital.Health"), GetHealthAttribute());
+        Map.Add(TEXT("Attribute.Vital.MaxHealth"), GetMaxHealthAttribute());
+        Map.Add(TEXT("Attribute.Vital.HealthRegenRate"), GetHealthRegenRateAttribute());
+        Map.Add(TEXT("Attribute.Vital.Mana"), GetManaAttribute());
+        Map.Add(TEXT("Attribute.Vital.MaxMana"), GetMaxManaAttribute());
+        Map.Add(TEXT("Attribute.Vital.ManaRegenRate"), GetManaRegenRateAttribute());
+        
+        return Map;
+    }();
+    
+    return StatTagMap;
+}
+
+FGameplayAttribute UWoWAttributeSet::GetAttributeForStatTag(const FGameplayTag& StatTag)
+{
+    if (!StatTag.IsValid())
+    {
+        return FGameplayAttribute();
+    }
+    
+    // FName hash lookup, no string conversion
+    const FGameplayAttribute* Attribute = GetStatTagAttributeMap().Find(StatTag.GetTagName());
+    return Attribute ? *Attribute : FGameplayAttribute();
+}
+
 void UWoWAttributeSet::OnRep_Health(const FGameplayAttributeData& OldHealth)
 {
     GAMEPLAYATTRIBUTE_REPNOTIFY(UWoWAttributeSet, Health, OldHealth);
@@ -150,6 +201,34 @@ void UWoWAttributeSet::PreAttributeChange(const FGameplayAttribute& Attribute, f
     }
 }
 
+void UWoWAttributeSet::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
+{
+    Super::PostAttributeChange(Attribute, OldValue, NewValue);
+    
+    if (Attribute != GetHealthAttribute())
+    {
+        return;
+    }
+    
+    // State.Dead follows Health on every write (effects, derived attribute updates, spawn setup),
+    // so anything that brings Health back above zero also clears it
+    UAbilitySystemComponent* OwningASC = GetOwningAbilitySystemComponent();
+    if (!OwningASC || !OwningASC->IsOwnerActorAuthoritative())
+    {
+        return;
+    }
+    
+    const bool bIsMarkedDead = OwningASC->HasMatchingGameplayTag(WoWGameplayTags::State_Dead);
+    if (NewValue <= 0.0f && !bIsMarkedDead)
+    {
+        OwningASC->AddLooseGameplayTag(WoWGameplayTags::State_Dead);
+    }
+    else if (NewValue > 0.0f && bIsMarkedDead)
+    {
+        OwningASC->RemoveLooseGameplayTag(WoWGameplayTags::State_Dead);
+    }
+}
+
 // WoWAttributeSet.cpp - Enhanced PostGameplayEffectExecute function
 void UWoWAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data)
 {
@@ -204,7 +283,6 @@ void UWoWAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbac
         SetHealth(FMath::Clamp(GetHealth(), 0.0f, GetMaxHealth()));
         UE_LOG(LogTemp, Warning, TEXT("Health after clamping: %.2f / %.2f"), GetHealth(), GetMaxHealth());
         
-        // Here you could handle death if health <= 0
         if (GetHealth() <= 0.0f)
         {
             UE_LOG(LogTemp, Warning, TEXT("Character health is zero or below - Death should be triggered"));
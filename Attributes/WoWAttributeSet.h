@@ -121,6 +121,9 @@ public:
     
     // PreAttributeChange is called before any modification happens
     virtual void PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue) override;
+    
+    // PostAttributeChange is called after every change, including direct base value writes
+    virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
 
     // Initialize attributes to their default values
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
@@ -128,6 +131,12 @@ public:
     // Recalculate derived attributes when base stats change
 // Recalculate derived attributes when base stats change
 void UpdateDerivedAttributes(UAbilitySystemComponent* AbilityComp);
+
+    // Map a stat tag (Attribute.Primary.Strength etc.) to its attribute. Returns an invalid attribute if unknown
+    static FGameplayAttribute GetAttributeForStatTag(const FGameplayTag& StatTag);
+    
+    // Every stat tag name the resolver knows, covering all attributes in this set
+    static const TMap<FName, FGameplayAttribute>& GetStatTagAttributeMap();
 protected:
     // Helper function to clamp attributes
     void AdjustAttributeForMaxChange(FGameplayAttributeData& AffectedAttribute, const FGameplayAttributeData& MaxAttribute, float NewMaxValue, const FGameplayAttribute& AffectedAttributeProperty);
@@ -0,0 +1,250 @@
+// File: CombatantGridSubsystem.cpp
+#include "CombatantGridSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+UCombatantGridSubsystem* UCombatantGridSubsystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UCombatantGridSubsystem>() : nullptr;
+}
+
+bool UCombatantGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatantGridSubsystem::Deinitialize()
+{
+    Combatants.Empty();
+    CombatantIndices.Empty();
+    Cells.Empty();
+
+    Super::Deinitialize();
+}
+
+TStatId UCombatantGridSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatantGridSubsystem, STATGROUP_Tickables);
+}
+
+FIntPoint UCombatantGridSubsystem::GetCell(const FVector& Location) const
+{
+    return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UCombatantGridSubsystem::AddToCell(int32 CombatantIndex)
+{
+    Cells.FindOrAdd(Combatants[CombatantIndex].Cell).Add(CombatantIndex);
+}
+
+void UCombatantGridSubsystem::RemoveFromCell(int32 CombatantIndex)
+{
+    const FIntPoint Cell = Combatants[CombatantIndex].Cell;
+    if (TArray<int32, TInlineAllocator<8>>* CellCombatants = Cells.Find(Cell))
+    {
+        CellCombatants->RemoveSingleSwap(CombatantIndex);
+        if (CellCombatants->Num() == 0)
+        {
+            Cells.Remove(Cell);
+        }
+    }
+}
+
+void UCombatantGridSubsystem::RegisterCombatant(AWoWCharacterBase* Character)
+{
+    if (!Character || CombatantIndices.Contains(Character))
+    {
+        return;
+    }
+
+    FCombatant NewCombatant;
+    NewCombatant.Character = Character;
+    NewCombatant.Location = Character->GetActorLocation();
+    NewCombatant.Cell = GetCell(NewCombatant.Location);
+    NewCombatant.Faction = Character->GetFaction();
+
+    const int32 CombatantIndex = Combatants.Add(NewCombatant);
+    CombatantIndices.Add(Character, CombatantIndex);
+    AddToCell(CombatantIndex);
+}
+
+void UCombatantGridSubsystem::UnregisterCombatant(AWoWCharacterBase* Character)
+{
+    int32 CombatantIndex = INDEX_NONE;
+    if (CombatantIndices.RemoveAndCopyValue(Character, CombatantIndex))
+    {
+        RemoveFromCell(CombatantIndex);
+        Combatants.RemoveAt(CombatantIndex);
+    }
+}
+
+void UCombatantGridSubsystem::RemoveCombatantAt(int32 CombatantIndex)
+{
+    // The character is already gone, so find its map entry by index
+    for (auto It = CombatantIndices.CreateIterator(); It; ++It)
+    {
+        if (It.Value() == CombatantIndex)
+        {
+            It.RemoveCurrent();
+            break;
+        }
+    }
+
+    RemoveFromCell(CombatantIndex);
+    Combatants.RemoveAt(CombatantIndex);
+}
+
+void UCombatantGridSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    // Refresh positions once per frame; only characters that crossed a cell edge touch the cell map
+    for (auto It = Combatants.CreateIterator(); It; ++It)
+    {
+        const int32 CombatantIndex = It.GetIndex();
+        FCombatant& Combatant = *It;
+
+        const AWoWCharacterBase* Character = Combatant.Character.Get();
+        if (!Character)
+        {
+            // Destroyed without EndPlay reaching us (world teardown)
+            RemoveCombatantAt(CombatantIndex);
+            continue;
+        }
+
+        Combatant.Location = Character->GetActorLocation();
+
+        const FIntPoint NewCell = GetCell(Combatant.Location);
+        if (NewCell != Combatant.Cell)
+        {
+            RemoveFromCell(CombatantIndex);
+            Combatant.Cell = NewCell;
+            AddToCell(CombatantIndex);
+        }
+    }
+}
+
+template<typename VisitorType>
+void UCombatantGridSubsystem::ForEachInRadius(const FVector& Center, float Radius, ECombatFaction Factions, const AActor* IgnoreActor, VisitorType&& Visitor) const
+{
+    if (Radius <= 0.0f || Combatants.Num() == 0)
+    {
+        return;
+    }
+
+    const FIntPoint MinCell = GetCell(Center - FVector(Radius, Radius, 0.0f));
+    const FIntPoint MaxCell = GetCell(Center + FVector(Radius, Radius, 0.0f));
+    const float RadiusSquared = FMath::Square(Radius);
+
+    for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+    {
+        for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+        {
+            const TArray<int32, TInlineAllocator<8>>* CellCombatants = Cells.Find(FIntPoint(CellX, CellY));
+            if (!CellCombatants)
+            {
+                continue;
+            }
+
+            for (const int32 CombatantIndex : *CellCombatants)
+            {
+                const FCombatant& Combatant = Combatants[CombatantIndex];
+                if (!EnumHasAnyFlags(Factions, Combatant.Faction))
+                {
+                    continue;
+                }
+
+                const float DistanceSquared = FVector::DistSquared(Center, Combatant.Location);
+                if (DistanceSquared > RadiusSquared)
+                {
+                    continue;
+                }
+
+                AWoWCharacterBase* Character = Combatant.Character.Get();
+                if (Character && Character != IgnoreActor)
+                {
+                    Visitor(*Character, Combatant.Location, DistanceSquared);
+                }
+            }
+        }
+    }
+}
+
+void UCombatantGridSubsystem::QueryRadius(const FVector& Center, float Radius, ECombatFaction Factions,
+    TArray<AWoWCharacterBase*>& OutCombatants, const AActor* IgnoreActor) const
+{
+    ForEachInRadius(Center, Radius, Factions, IgnoreActor,
+        [&OutCombatants](AWoWCharacterBase& Character, const FVector& Location, float DistanceSquared)
+        {
+            OutCombatants.Add(&Character);
+        });
+}
+
+void UCombatantGridSubsystem::QueryCone(const FVector& Origin, const FVector& Direction, float Range, float HalfAngleDegrees,
+    ECombatFaction Factions, TArray<AWoWCharacterBase*>& OutCombatants, const AActor* IgnoreActor) const
+{
+    const FVector ConeDirection = Direction.GetSafeNormal();
+    if (ConeDirection.IsNearlyZero())
+    {
+        return;
+    }
+
+    const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.0f, 180.0f)));
+
+    ForEachInRadius(Origin, Range, Factions, IgnoreActor,
+        [&OutCombatants, &Origin, &ConeDirection, CosHalfAngle](AWoWCharacterBase& Character, const FVector& Location, float DistanceSquared)
+        {
+            // Standing on the apex counts as inside
+            const FVector ToCombatant = Location - Origin;
+            if (DistanceSquared <= KINDA_SMALL_NUMBER || FVector::DotProduct(ToCombatant, ConeDirection) >= CosHalfAngle * FMath::Sqrt(DistanceSquared))
+            {
+                OutCombatants.Add(&Character);
+            }
+        });
+}
+
+void UCombatantGridSubsystem::QueryNearest(const FVector& Center, int32 Count, float MaxRadius, ECombatFaction Factions,
+    TArray<AWoWCharacterBase*>& OutCombatants, const AActor* IgnoreActor) const
+{
+    if (Count <= 0)
+    {
+        return;
+    }
+
+    TArray<TPair<float, AWoWCharacterBase*>, TInlineAllocator<32>> Candidates;
+    ForEachInRadius(Center, MaxRadius, Factions, IgnoreActor,
+        [&Candidates](AWoWCharacterBase& Character, const FVector& Location, float DistanceSquared)
+        {
+            Candidates.Emplace(DistanceSquared, &Character);
+        });
+
+    Candidates.Sort([](const TPair<float, AWoWCharacterBase*>& A, const TPair<float, AWoWCharacterBase*>& B)
+    {
+        return A.Key < B.Key;
+    });
+
+    const int32 NumResults = FMath::Min(Count, Candidates.Num());
+    for (int32 Index = 0; Index < NumResults; ++Index)
+    {
+        OutCombatants.Add(Candidates[Index].Value);
+    }
+}
+
+AWoWCharacterBase* UCombatantGridSubsystem::FindNearest(const FVector& Center, float MaxRadius, ECombatFaction Factions, const AActor* IgnoreActor) const
+{
+    AWoWCharacterBase* Nearest = nullptr;
+    float NearestDistanceSquared = TNumericLimits<float>::Max();
+
+    ForEachInRadius(Center, MaxRadius, Factions, IgnoreActor,
+        [&Nearest, &NearestDistanceSquared](AWoWCharacterBase& Character, const FVector& Location, float DistanceSquared)
+        {
+            if (DistanceSquared < NearestDistanceSquared)
+            {
+                Nearest = &Character;
+                NearestDistanceSquared = DistanceSquared;
+            }
+        });
+
+    return Nearest;
+}
@@ -0,0 +1,77 @@
+// File: CombatantGridSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WoWCharacterBase.h"
+#include "CombatantGridSubsystem.generated.h"
+
+// Uniform grid over every AWoWCharacterBase in the world, bucketed on the ground plane.
+// Characters register themselves in BeginPlay / EndPlay and their cells are refreshed every frame,
+// so AoE, fallback targeting and AI queries only look at the few cells they overlap instead of
+// walking every actor in the world
+UCLASS()
+class MYPROJECT5_API UCombatantGridSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    // The grid for the world the object lives in, nullptr outside game worlds
+    static UCombatantGridSubsystem* Get(const UObject* WorldContextObject);
+
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    void RegisterCombatant(AWoWCharacterBase* Character);
+    void UnregisterCombatant(AWoWCharacterBase* Character);
+
+    // Every combatant of the given factions within Radius of Center. Appends to OutCombatants
+    void QueryRadius(const FVector& Center, float Radius, ECombatFaction Factions,
+        TArray<AWoWCharacterBase*>& OutCombatants, const AActor* IgnoreActor = nullptr) const;
+
+    // Every combatant within Range of Origin and at most HalfAngleDegrees off Direction. Appends to OutCombatants
+    void QueryCone(const FVector& Origin, const FVector& Direction, float Range, float HalfAngleDegrees, ECombatFaction Factions,
+        TArray<AWoWCharacterBase*>& OutCombatants, const AActor* IgnoreActor = nullptr) const;
+
+    // Up to Count combatants within MaxRadius of Center, nearest first. Appends to OutCombatants
+    void QueryNearest(const FVector& Center, int32 Count, float MaxRadius, ECombatFaction Factions,
+        TArray<AWoWCharacterBase*>& OutCombatants, const AActor* IgnoreActor = nullptr) const;
+
+    // The closest combatant within MaxRadius, nullptr if there is none
+    AWoWCharacterBase* FindNearest(const FVector& Center, float MaxRadius, ECombatFaction Factions, const AActor* IgnoreActor = nullptr) const;
+
+    int32 GetNumCombatants() const { return Combatants.Num(); }
+
+protected:
+    struct FCombatant
+    {
+        TWeakObjectPtr<AWoWCharacterBase> Character;
+        FVector Location = FVector::ZeroVector;
+        FIntPoint Cell = FIntPoint::ZeroValue;
+        ECombatFaction Faction = ECombatFaction::None;
+    };
+
+    FIntPoint GetCell(const FVector& Location) const;
+
+    void AddToCell(int32 CombatantIndex);
+    void RemoveFromCell(int32 CombatantIndex);
+
+    void RemoveCombatantAt(int32 CombatantIndex);
+
+    // Call Visitor(Character, Location, DistanceSquared) for every live combatant of the factions within Radius of Center
+    template<typename VisitorType>
+    void ForEachInRadius(const FVector& Center, float Radius, ECombatFaction Factions, const AActor* IgnoreActor, VisitorType&& Visitor) const;
+
+    // Edge length of one grid cell. Roughly the largest common query radius keeps most queries to 4-9 cells
+    float CellSize = 1000.0f;
+
+    TSparseArray<FCombatant> Combatants;
+
+    // Character -> index into Combatants. Entries are removed in EndPlay, so the raw key never dangles
+    TMap<const AWoWCharacterBase*, int32> CombatantIndices;
+
+    // Cell -> indices into Combatants
+    TMap<FIntPoint, TArray<int32, TInlineAllocator<8>>> Cells;
+};
@@ -4,7 +4,9 @@
 #include "GameplayEffect.h"
 #include "GameplayAbilitySpec.h"
 #include "../Components/EffectApplicationComponent.h"
+#include "../Components/CombatStateComponent.h"
 #include "../States/WoWPlayerState.h"
+#include "CombatantGridSubsystem.h"
 
 AWoWCharacterBase::AWoWCharacterBase()
 {
@@ -14,6 +16,7 @@ AWoWCharacterBase::AWoWCharacterBase()
     // Flag to track ability initialization
     bAbilitiesInitialized = false;
     EffectApplicationComponent = CreateDefaultSubobject<UEffectApplicationComponent>(TEXT("EffectApplicationComponent"));
+    CombatStateComponent = CreateDefaultSubobject<UCombatStateComponent>(TEXT("CombatStateComponent"));
 
 }
 
@@ -24,8 +27,24 @@ void AWoWCharacterBase::BeginPlay()
     {
         EffectApplicationComponent->SetEffectDataAsset(EffectDataAsset);
     }
-
+    
     // Initialization moved to PossessedBy or OnRep_PlayerState
+    
+    // Make this character findable by radius, cone and nearest queries
+    if (UCombatantGridSubsystem* CombatantGrid = UCombatantGridSubsystem::Get(this))
+    {
+        CombatantGrid->RegisterCombatant(this);
+    }
+}
+
+void AWoWCharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UCombatantGridSubsystem* CombatantGrid = UCombatantGridSubsystem::Get(this))
+    {
+        CombatantGrid->UnregisterCombatant(this);
+    }
+    
+    Super::EndPlay(EndPlayReason);
 }
 
 void AWoWCharacterBase::Tick(float DeltaTime)
@@ -50,6 +69,16 @@ UAbilitySystemComponent* AWoWCharacterBase::GetAbilitySystemComponent() const
     return nullptr;
 }
 
+void AWoWCharacterBase::HandleGameplayCue(UObject* Self, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters)
+{
+    if (EffectApplicationComponent && EffectApplicationComponent->HandleFeedbackCue(GameplayCueTag, EventType, Parameters))
+    {
+        return;
+    }
+    
+    IGameplayCueInterface::HandleGameplayCue(Self, GameplayCueTag, EventType, Parameters);
+}
+
 UWoWAttributeSet* AWoWCharacterBase::GetAttributeSet() const
 {
     // AttributeSet now comes from PlayerState for player characters
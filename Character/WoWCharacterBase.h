@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "AbilitySystemInterface.h"
+#include "GameplayCueInterface.h"
 #include "GameplayEffectTypes.h"
 #include "WoWCharacterBase.generated.h"
 
@@ -12,6 +13,7 @@ class UWoWAttributeSet;
 class UGameplayEffect;
 class UGameplayAbility;
 class UEffectApplicationComponent;
+class UCombatStateComponent;
 class UEffectDataAsset;
 class UAbilityDataAsset;
 
@@ -25,8 +27,20 @@ class UAbilityDataAsset;
         StrafeRight UMETA(DisplayName = "Strafe Right"),
     };
 
+// Which side a character fights on. Single bits so spatial queries can filter on any combination
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class ECombatFaction : uint8
+{
+    None    = 0 UMETA(Hidden),
+    Player  = 1 << 0,
+    Enemy   = 1 << 1,
+    Neutral = 1 << 2,
+    All     = 0x07 UMETA(Hidden)
+};
+ENUM_CLASS_FLAGS(ECombatFaction);
+
 UCLASS()
-class MYPROJECT5_API AWoWCharacterBase : public ACharacter, public IAbilitySystemInterface
+class MYPROJECT5_API AWoWCharacterBase : public ACharacter, public IAbilitySystemInterface, public IGameplayCueInterface
 {
     GENERATED_BODY()
 
@@ -55,6 +69,9 @@ bool IsMoving() const;
     // Implement the IAbilitySystemInterface
     virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
 
+    // Effect feedback cues are played by the effect component, everything else goes to the default routing
+    virtual void HandleGameplayCue(UObject* Self, FGameplayTag GameplayCueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters) override;
+
     // Returns the attribute set
     virtual UWoWAttributeSet* GetAttributeSet() const;
 
@@ -71,6 +88,13 @@ bool IsMoving() const;
     UFUNCTION(BlueprintPure, Category = "Effects")
     UEffectApplicationComponent* GetEffectApplicationComponent() const { return EffectApplicationComponent; }
     
+    // Faction used by the combatant grid to filter queries
+    virtual ECombatFaction GetFaction() const { return ECombatFaction::Neutral; }
+    
+    // Get the combat state bits used to gate attacks and abilities
+    UFUNCTION(BlueprintPure, Category = "Combat")
+    UCombatStateComponent* GetCombatStateComponent() const { return CombatStateComponent; }
+    
     // Get the Ability Data Asset
     UFUNCTION(BlueprintPure, Category = "Abilities")
     UAbilityDataAsset* GetAbilityDataAsset() const { return AbilityDataAsset; }
@@ -112,11 +136,17 @@ protected:
     // Called when the game starts or when spawned
     virtual void BeginPlay() override;
     
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    
    EMovementStance DirectionToStance(float Direction) const;
 
     // Effect Application component
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Effects")
     UEffectApplicationComponent* EffectApplicationComponent;
+    
+    // Combat state bitfield, bound to the ASC once its actor info is initialized
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
+    UCombatStateComponent* CombatStateComponent;
 
     // Default attributes that will be used to set our starting values
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Abilities")
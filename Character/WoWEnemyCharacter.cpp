@@ -1,6 +1,8 @@
 #include "WoWEnemyCharacter.h"
 #include "AbilitySystemComponent.h"
 #include "../Attributes/WoWAttributeSet.h"
+#include "../Data/ScalingCurveDataAsset.h"
+#include "../Components/CombatStateComponent.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "Perception/PawnSensingComponent.h"
 #include "../AI/WoWEnemyController.h"
@@ -9,6 +11,43 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Math/UnrealMathUtility.h"
 
+namespace
+{
+    // Curves each enemy type can read from its scaling asset
+    enum EEnemyScalingCurve
+    {
+        StrengthCurve,
+        AgilityCurve,
+        IntellectCurve,
+        StaminaCurve,
+        SpiritCurve,
+        DamageCurve,
+        NumEnemyScalingCurves
+    };
+    
+    // "Enemy.<Type>.<Curve>", built once instead of per spawn
+    FName GetEnemyCurveName(EEnemyType Type, EEnemyScalingCurve Curve)
+    {
+        static const TArray<FName> CurveNames = []()
+        {
+            const TCHAR* TypeNames[] = { TEXT("Melee"), TEXT("Ranged"), TEXT("Caster") };
+            const TCHAR* StatNames[] = { TEXT("Strength"), TEXT("Agility"), TEXT("Intellect"), TEXT("Stamina"), TEXT("Spirit"), TEXT("Damage") };
+            
+            TArray<FName> Names;
+            for (const TCHAR* TypeName : TypeNames)
+            {
+                for (const TCHAR* StatName : StatNames)
+                {
+                    Names.Add(FName(*FString::Printf(TEXT("Enemy.%s.%s"), TypeName, StatName)));
+                }
+            }
+            return Names;
+        }();
+        
+        return CurveNames[static_cast<int32>(Type) * NumEnemyScalingCurves + Curve];
+    }
+}
+
 AWoWEnemyCharacter::AWoWEnemyCharacter()
 {
     PawnSensingComponent = CreateDefaultSubobject<UPawnSensingComponent>(TEXT("PawnSensingComponent"));
@@ -25,6 +64,8 @@ AWoWEnemyCharacter::AWoWEnemyCharacter()
     
     Level = 1;
     EnemyType = EEnemyType::Melee;
+    ScalingCurves = nullptr;
+    DamageLevelScale = 1.0f + (Level * 0.05f);
     WeaponDamageRange = FVector2D(5.0f, 7.0f);
     SightRadius = 800.0f;
     
@@ -47,6 +88,7 @@ void AWoWEnemyCharacter::BeginPlay()
     if (AbilitySystemComponent)
     {
         AbilitySystemComponent->InitAbilityActorInfo(this, this);
+        CombatStateComponent->BindToAbilitySystem(AbilitySystemComponent);
         UE_LOG(LogTemp, Warning, TEXT("Enemy %s initialized ASC"), *GetName());
     }
     else
@@ -95,12 +137,20 @@ void AWoWEnemyCharacter::PossessedBy(AController* NewController)
 
 void AWoWEnemyCharacter::InitializeEnemy()
 {
+    // Baked curve value for this type and level, or the linear fallback
+    auto GetCurveScale = [this](EEnemyScalingCurve Curve, float FallbackScale)
+    {
+        return ScalingCurves ? ScalingCurves->GetValue(GetEnemyCurveName(EnemyType, Curve), Level, FallbackScale) : FallbackScale;
+    };
+    
+    DamageLevelScale = GetCurveScale(DamageCurve, 1.0f + (Level * 0.05f));
+    
     // Apply the default attribute effect, which will set primary stats
     if (DefaultAttributeEffect && AbilitySystemComponent)
     {
         UE_LOG(LogTemp, Warning, TEXT("Enemy %s initializing attributes"), *GetName());
         
-        // Apply level scaling (roughly 10% increase per level)
+        // Fallback level scaling (roughly 10% increase per level) for stats without a curve
         float LevelScaling = 1.0f + ((Level - 1) * 0.1f);
         
         // Apply the effect to set initial attribute values
@@ -158,12 +208,12 @@ void AWoWEnemyCharacter::InitializeEnemy()
                 float CurrentStamina = WoWAS->GetStamina();
                 float CurrentSpirit = WoWAS->GetSpirit();
                 
-                // Apply modifiers
-                WoWAS->SetStrength(CurrentStrength * StrengthMod * LevelScaling);
-                WoWAS->SetAgility(CurrentAgility * AgilityMod * LevelScaling);
-                WoWAS->SetIntellect(CurrentIntellect * IntellectMod * LevelScaling);
-                WoWAS->SetStamina(CurrentStamina * StaminaMod * LevelScaling);
-                WoWAS->SetSpirit(CurrentSpirit * SpiritMod * LevelScaling);
+                // Apply modifiers. A curve covers both the type modifier and the level scaling
+                WoWAS->SetStrength(CurrentStrength * GetCurveScale(StrengthCurve, StrengthMod * LevelScaling));
+                WoWAS->SetAgility(CurrentAgility * GetCurveScale(AgilityCurve, AgilityMod * LevelScaling));
+                WoWAS->SetIntellect(CurrentIntellect * GetCurveScale(IntellectCurve, IntellectMod * LevelScaling));
+                WoWAS->SetStamina(CurrentStamina * GetCurveScale(StaminaCurve, StaminaMod * LevelScaling));
+                WoWAS->SetSpirit(CurrentSpirit * GetCurveScale(SpiritCurve, SpiritMod * LevelScaling));
                 
                 // Update derived attributes (health, mana, etc.)
                 WoWAS->UpdateDerivedAttributes(AbilitySystemComponent);
@@ -257,7 +307,7 @@ float AWoWEnemyCharacter::CalculateBaseDamage() const
     float BaseDamage = WeaponDamage + (AttackPower / 14.0f);
     
     // Scale with level for balance
-    return BaseDamage * (1.0f + (Level * 0.05f));
+    return BaseDamage * DamageLevelScale;
 }
 
 void AWoWEnemyCharacter::OnPawnSeen(APawn* SeenPawn)
@@ -8,6 +8,7 @@ class UBehaviorTree;
 class UPawnSensingComponent;
 class UAbilitySystemComponent;
 class UWoWAttributeSet;
+class UScalingCurveDataAsset;
 
 // Enemy type enum (melee, ranged, caster)
 UENUM(BlueprintType)
@@ -50,6 +51,11 @@ public:
     // Override the base class functions to return the ASC on this enemy
     virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
     virtual UWoWAttributeSet* GetAttributeSet() const override;
+    
+    virtual ECombatFaction GetFaction() const override { return ECombatFaction::Enemy; }
+    
+    // Detection range
+    float GetSightRadius() const { return SightRadius; }
 
 protected:
     // Component for detecting players
@@ -68,6 +74,14 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stats")
     EEnemyType EnemyType;
     
+    // Per-level multipliers baked from curves named "Enemy.<Type>.<Stat>" (Strength, Agility, Intellect,
+    // Stamina, Spirit) and "Enemy.<Type>.Damage". A missing curve falls back to the built-in linear growth
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+    UScalingCurveDataAsset* ScalingCurves;
+    
+    // Damage multiplier for the current level, resolved once in InitializeEnemy
+    float DamageLevelScale;
+    
     // Base weapon damage range (min-max)
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat")
     FVector2D WeaponDamageRange;
@@ -12,6 +12,8 @@
 #include "../Components/EffectApplicationComponent.h" // Add this include
 #include "../Data/AbilityDataAsset.h" // Add this include
 #include "../Data/AbilityEffectTypes.h" // Add this include
+#include "../Data/CombatDatabaseSubsystem.h"
+#include "../Components/CombatStateComponent.h"
 #include "Engine/Engine.h"
 
 
@@ -418,6 +420,8 @@ void AWoWPlayerCharacter::PossessedBy(AController* NewController)
             ASC->InitAbilityActorInfo(PS, this);
             UE_LOG(LogTemp, Warning, TEXT("**** ASC Actor Info Initialized ****"));
             
+            CombatStateComponent->BindToAbilitySystem(ASC);
+            
             // Initialize attributes and abilities
             InitializeAttributes();
             GiveAbilities();
@@ -522,6 +526,32 @@ void AWoWPlayerCharacter::Server_ApplyAbilityEffect_Implementation(int32 Ability
         return;
     }
     
+    // Dedicated servers read the ability and its effects straight from the mapped combat database when it
+    // was built from this character's tables
+    const UCombatDatabaseSubsystem* CombatDatabase = GetGameInstance() ? GetGameInstance()->GetSubsystem<UCombatDatabaseSubsystem>() : nullptr;
+    TArray<int32> EffectIDs;
+    if (CombatDatabase && CombatDatabase->GetAbilityEffectIDs(GetAbilityDataAsset(), AbilityID, EEffectContainerType::Target, EffectIDs))
+    {
+        // Drop IDs the effect table does not have before anything is applied
+        const UEffectDataAsset* EffectData = GetEffectDataAsset();
+        if (EffectData && CombatDatabase->GetDatabase()->IsCurrentFor(EffectData))
+        {
+            EffectIDs.RemoveAll([CombatDatabase, EffectData](int32 EffectID)
+            {
+                return CombatDatabase->FindEffect(EffectData, EffectID) == nullptr;
+            });
+        }
+        
+        if (EffectIDs.Num() > 0)
+        {
+            bool Success = EffectComp->ApplyEffectsToTarget(EffectIDs, Target);
+            
+            UE_LOG(LogTemp, Warning, TEXT("Server applied effects to target: %s"), 
+                Success ? TEXT("Success") : TEXT("Failed"));
+        }
+        return;
+    }
+    
     // Get ability data to find effect IDs
     UAbilityDataAsset* AbilityAsset = GetAbilityDataAsset();
     if (!AbilityAsset)
@@ -530,14 +560,14 @@ void AWoWPlayerCharacter::Server_ApplyAbilityEffect_Implementation(int32 Ability
         return;
     }
     
-    FAbilityTableRow AbilityData;
-    if (AbilityAsset->GetAbilityDataByID(AbilityID, AbilityData))
+    const FAbilityTableRow* AbilityData = AbilityAsset->FindAbilityDataByID(AbilityID);
+    if (AbilityData)
     {
         // Apply the target effects from this ability
-        if (AbilityData.TargetEffects.EffectIDs.Num() > 0)
+        if (AbilityData->TargetEffects.EffectIDs.Num() > 0)
         {
             // Apply effects to the target
-            bool Success = EffectComp->ApplyEffectContainerToTarget(AbilityData.TargetEffects, Target);
+            bool Success = EffectComp->ApplyEffectContainerToTarget(AbilityData->TargetEffects, Target);
             
             UE_LOG(LogTemp, Warning, TEXT("Server applied effects to target: %s"), 
                 Success ? TEXT("Success") : TEXT("Failed"));
@@ -47,6 +47,7 @@ public:
     float CameraZoomStep = 50.0f;
     virtual float GetForwardInput() const { return ForwardInputValue; }
     virtual float GetRightInput() const { return RightInputValue; }
+    virtual ECombatFaction GetFaction() const override { return ECombatFaction::Player; }
 
 // Add to WoWPlayerCharacter.h in the public section
 public:
@@ -163,7 +163,7 @@ void UCastingComponent::NotifyCastStarted(const FString& InSpellName, float InCa
     bCanCastWhileMoving = InCanCastWhileMoving;
     
     // Update the cast state
-    CastingState = ECastingState::Casting;
+    SetCastingState(ECastingState::Casting);
     
     // Store the current position to detect movement
     if (GetOwner())
@@ -182,7 +182,7 @@ void UCastingComponent::NotifyCastCompleted()
         Server_NotifyCastCompleted();
     }
     
-    CastingState = ECastingState::Idle;
+    SetCastingState(ECastingState::Idle);
     ClientCastProgress = 0.0f;
     
     UE_LOG(LogTemp, Log, TEXT("Cast Completed: %s"), *SpellName);
@@ -196,7 +196,7 @@ void UCastingComponent::NotifyCastInterrupted()
     }
     
     // Set state to Interrupted
-    CastingState = ECastingState::Interrupted;
+    SetCastingState(ECastingState::Interrupted);
     
     // Freeze the cast progress where it was interrupted
     // This will be used for the original cast bar
@@ -248,10 +248,21 @@ void UCastingComponent::ClearInterruptState()
     // If we're still in Interrupted state, set to Idle
     if (CastingState == ECastingState::Interrupted)
     {
-        CastingState = ECastingState::Idle;
+        SetCastingState(ECastingState::Idle);
     }
 }
 
+void UCastingComponent::SetCastingState(ECastingState NewState)
+{
+    if (CastingState == NewState)
+    {
+        return;
+    }
+    
+    CastingState = NewState;
+    OnCastingStateChanged.Broadcast(CastingState);
+}
+
 bool UCastingComponent::IsCasting() const
 {
     return CastingState == ECastingState::Casting;
@@ -300,6 +311,8 @@ void UCastingComponent::OnRep_CastingState()
            (CastingState == ECastingState::Casting) ? TEXT("Casting") : TEXT("Interrupted"), 
            *SpellName);
     
+    OnCastingStateChanged.Broadcast(CastingState);
+    
     if (CastingState == ECastingState::Casting)
     {
         CastStartTime = GetWorldTime();
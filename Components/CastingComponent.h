@@ -14,6 +14,9 @@ enum class ECastingState : uint8
     Interrupted UMETA(DisplayName = "Interrupted")
 };
 
+// Broadcast whenever the casting state changes, locally and on replication
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnCastingStateChanged, ECastingState /*NewState*/);
+
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class MYPROJECT5_API UCastingComponent : public UActorComponent
 {
@@ -47,6 +50,8 @@ public:
     
     UFUNCTION(BlueprintPure, Category = "Casting")
     bool CanCastWhileMoving() const { return bCanCastWhileMoving; }
+    
+    FOnCastingStateChanged OnCastingStateChanged;
 
 protected:
     virtual void BeginPlay() override;
@@ -66,6 +71,9 @@ protected:
     UFUNCTION()
     void ClearInterruptState();
     
+    // Every state change goes through here so listeners see it
+    void SetCastingState(ECastingState NewState);
+    
     // Check if the owning character is moving
     bool IsOwnerMoving() const;
     
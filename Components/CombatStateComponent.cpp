@@ -0,0 +1,190 @@
+// File: CombatStateComponent.cpp
+#include "CombatStateComponent.h"
+#include "CastingComponent.h"
+#include "AbilitySystemComponent.h"
+#include "Net/UnrealNetwork.h"
+#include "TimerManager.h"
+#include "../Character/WoWCharacterBase.h"
+#include "../WoWGameplayTags.h"
+
+namespace
+{
+    struct FCombatStateTag
+    {
+        FGameplayTag Tag;
+        ECombatStateFlags Flag;
+    };
+
+    // Tags that drive a combat state bit. Parent tags fire when any child tag is added or removed
+    const TArray<FCombatStateTag>& GetCombatStateTags()
+    {
+        static const TArray<FCombatStateTag> Tags = {
+            { WoWGameplayTags::Ability_AutoAttack_Active, ECombatStateFlags::AutoAttacking },
+            { WoWGameplayTags::State_Stunned, ECombatStateFlags::Stunned },
+            { WoWGameplayTags::State_Dead, ECombatStateFlags::Dead },
+            { WoWGameplayTags::Enemy_Attack_Cooldown, ECombatStateFlags::AttackCooldown },
+            { WoWGameplayTags::Ability_Cooldown, ECombatStateFlags::AbilityCooldown }
+        };
+        return Tags;
+    }
+}
+
+UCombatStateComponent::UCombatStateComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+    SetIsReplicatedByDefault(true);
+
+    CombatState = 0;
+}
+
+void UCombatStateComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    // Only the owner gates its own input on this, everyone else sees tags and the cast bar
+    DOREPLIFETIME_CONDITION(UCombatStateComponent, CombatState, COND_OwnerOnly);
+}
+
+void UCombatStateComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (!HasStateAuthority())
+    {
+        return;
+    }
+
+    // Cast state is not a tag, so follow the casting component directly
+    if (UCastingComponent* CastingComponent = GetOwner()->FindComponentByClass<UCastingComponent>())
+    {
+        CastingStateChangedHandle = CastingComponent->OnCastingStateChanged.AddUObject(this, &UCombatStateComponent::OnCastingStateChanged);
+        BoundCastingComponent = CastingComponent;
+        SetStateFlag(ECombatStateFlags::Casting, CastingComponent->IsCasting());
+    }
+}
+
+void UCombatStateComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    UnbindAbilitySystem();
+
+    if (UCastingComponent* CastingComponent = BoundCastingComponent.Get())
+    {
+        CastingComponent->OnCastingStateChanged.Remove(CastingStateChangedHandle);
+    }
+    CastingStateChangedHandle.Reset();
+    BoundCastingComponent.Reset();
+
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(GlobalCooldownTimerHandle);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UCombatStateComponent::BindToAbilitySystem(UAbilitySystemComponent* InAbilitySystem)
+{
+    if (!HasStateAuthority() || BoundAbilitySystem.Get() == InAbilitySystem)
+    {
+        return;
+    }
+
+    UnbindAbilitySystem();
+
+    if (!InAbilitySystem)
+    {
+        return;
+    }
+
+    BoundAbilitySystem = InAbilitySystem;
+
+    for (const FCombatStateTag& Entry : GetCombatStateTags())
+    {
+        TagEventHandles.Add(InAbilitySystem->RegisterGameplayTagEvent(Entry.Tag, EGameplayTagEventType::NewOrRemoved)
+            .AddUObject(this, &UCombatStateComponent::OnTagCountChanged, Entry.Flag));
+
+        // Pick up anything that was granted before we started listening
+        SetStateFlag(Entry.Flag, InAbilitySystem->HasMatchingGameplayTag(Entry.Tag));
+    }
+}
+
+void UCombatStateComponent::UnbindAbilitySystem()
+{
+    if (UAbilitySystemComponent* OldAbilitySystem = BoundAbilitySystem.Get())
+    {
+        const TArray<FCombatStateTag>& Tags = GetCombatStateTags();
+        for (int32 Index = 0; Index < TagEventHandles.Num(); ++Index)
+        {
+            OldAbilitySystem->RegisterGameplayTagEvent(Tags[Index].Tag, EGameplayTagEventType::NewOrRemoved).Remove(TagEventHandles[Index]);
+        }
+    }
+
+    TagEventHandles.Reset();
+    BoundAbilitySystem.Reset();
+}
+
+void UCombatStateComponent::OnTagCountChanged(const FGameplayTag Tag, int32 NewCount, ECombatStateFlags Flag)
+{
+    SetStateFlag(Flag, NewCount > 0);
+}
+
+void UCombatStateComponent::OnCastingStateChanged(ECastingState NewState)
+{
+    SetStateFlag(ECombatStateFlags::Casting, NewState == ECastingState::Casting);
+}
+
+void UCombatStateComponent::StartGlobalCooldown(float Duration)
+{
+    UWorld* World = GetWorld();
+    if (!World || Duration <= 0.0f || !HasStateAuthority())
+    {
+        return;
+    }
+
+    SetStateFlag(ECombatStateFlags::GlobalCooldown, true);
+    World->GetTimerManager().SetTimer(GlobalCooldownTimerHandle, this, &UCombatStateComponent::ClearGlobalCooldown, Duration, false);
+}
+
+void UCombatStateComponent::ClearGlobalCooldown()
+{
+    SetStateFlag(ECombatStateFlags::GlobalCooldown, false);
+}
+
+bool UCombatStateComponent::HasStateAuthority() const
+{
+    const AActor* Owner = GetOwner();
+    return Owner && Owner->HasAuthority();
+}
+
+void UCombatStateComponent::SetStateFlag(ECombatStateFlags Flag, bool bEnabled)
+{
+    const uint8 OldState = CombatState;
+    const uint8 NewState = bEnabled ? (OldState | static_cast<uint8>(Flag)) : (OldState & ~static_cast<uint8>(Flag));
+
+    if (NewState == OldState)
+    {
+        return;
+    }
+
+    CombatState = NewState;
+    OnCombatStateChanged.Broadcast(static_cast<ECombatStateFlags>(OldState), static_cast<ECombatStateFlags>(NewState));
+}
+
+void UCombatStateComponent::OnRep_CombatState(uint8 OldState)
+{
+    if (OldState != CombatState)
+    {
+        OnCombatStateChanged.Broadcast(static_cast<ECombatStateFlags>(OldState), static_cast<ECombatStateFlags>(CombatState));
+    }
+}
+
+UCombatStateComponent* UCombatStateComponent::FindForActor(const AActor* Actor)
+{
+    // Every character creates one, so the common case is a cast rather than a component search
+    if (const AWoWCharacterBase* Character = Cast<AWoWCharacterBase>(Actor))
+    {
+        return Character->GetCombatStateComponent();
+    }
+
+    return Actor ? Actor->FindComponentByClass<UCombatStateComponent>() : nullptr;
+}
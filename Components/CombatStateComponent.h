@@ -0,0 +1,111 @@
+// File: CombatStateComponent.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GameplayTagContainer.h"
+#include "CombatStateComponent.generated.h"
+
+class UAbilitySystemComponent;
+class UCastingComponent;
+enum class ECastingState : uint8;
+
+// One bit per combat state the gating code branches on
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class ECombatStateFlags : uint8
+{
+    None            = 0 UMETA(Hidden),
+    Casting         = 1 << 0,   // Cast bar running
+    AutoAttacking   = 1 << 1,   // Ability.AutoAttack.Active
+    Stunned         = 1 << 2,   // State.Stunned
+    GlobalCooldown  = 1 << 3,   // Hotbar global cooldown running
+    Dead            = 1 << 4,   // State.Dead
+    AttackCooldown  = 1 << 5,   // Enemy.Attack.Cooldown
+    AbilityCooldown = 1 << 6    // Any Ability.Cooldown.* tag
+};
+ENUM_CLASS_FLAGS(ECombatStateFlags);
+
+// Nothing can be started while any of these is set
+static constexpr ECombatStateFlags CombatStateIncapacitated = ECombatStateFlags::Dead | ECombatStateFlags::Stunned;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnCombatStateChanged, ECombatStateFlags /*OldState*/, ECombatStateFlags /*NewState*/);
+
+// Per-character combat state packed into one byte. Kept up to date from ASC tag events and the casting
+// component instead of being queried tag by tag, so every gate is a single mask test.
+// Only the server writes it (some of its tags, such as State.Dead, are never replicated); the owning
+// client reads the replicated copy and never changes it
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class MYPROJECT5_API UCombatStateComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UCombatStateComponent();
+
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    // Listen to tag changes on this ASC (call once its actor info is initialized). Re-binding swaps the ASC.
+    // Does nothing on clients
+    void BindToAbilitySystem(UAbilitySystemComponent* InAbilitySystem);
+
+    ECombatStateFlags GetCombatState() const { return static_cast<ECombatStateFlags>(CombatState); }
+
+    // True if any of the flags is set
+    bool HasAnyState(ECombatStateFlags Flags) const { return (CombatState & static_cast<uint8>(Flags)) != 0; }
+
+    // True if none of the flags is set
+    bool HasNoState(ECombatStateFlags Flags) const { return (CombatState & static_cast<uint8>(Flags)) == 0; }
+
+    UFUNCTION(BlueprintPure, Category = "Combat")
+    bool IsCasting() const { return HasAnyState(ECombatStateFlags::Casting); }
+
+    UFUNCTION(BlueprintPure, Category = "Combat")
+    bool IsDead() const { return HasAnyState(ECombatStateFlags::Dead); }
+
+    UFUNCTION(BlueprintPure, Category = "Combat")
+    bool IsIncapacitated() const { return HasAnyState(CombatStateIncapacitated); }
+
+    // Set the global cooldown bit for Duration seconds. Does nothing on clients
+    void StartGlobalCooldown(float Duration);
+
+    // The combat state component of a character, nullptr if it has none
+    static UCombatStateComponent* FindForActor(const AActor* Actor);
+
+    // Fired whenever a bit changes, on the server and on replication
+    FOnCombatStateChanged OnCombatStateChanged;
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    // True where this component may write its state
+    bool HasStateAuthority() const;
+
+    void SetStateFlag(ECombatStateFlags Flag, bool bEnabled);
+
+    void OnTagCountChanged(const FGameplayTag Tag, int32 NewCount, ECombatStateFlags Flag);
+
+    void OnCastingStateChanged(ECastingState NewState);
+
+    void ClearGlobalCooldown();
+
+    void UnbindAbilitySystem();
+
+    UFUNCTION()
+    void OnRep_CombatState(uint8 OldState);
+
+    // ECombatStateFlags bits
+    UPROPERTY(ReplicatedUsing = OnRep_CombatState)
+    uint8 CombatState;
+
+    TWeakObjectPtr<UAbilitySystemComponent> BoundAbilitySystem;
+
+    // One handle per entry of the tag -> flag table
+    TArray<FDelegateHandle, TInlineAllocator<4>> TagEventHandles;
+
+    TWeakObjectPtr<UCastingComponent> BoundCastingComponent;
+
+    FDelegateHandle CastingStateChangedHandle;
+
+    FTimerHandle GlobalCooldownTimerHandle;
+};
@@ -1,20 +1,76 @@
 // File: EffectApplicationComponent.cpp
 #include "EffectApplicationComponent.h"
 #include "../Data/EffectDataAsset.h"
+#include "../Data/EffectFormula.h"
+#include "../Data/ScalingCurveDataAsset.h"
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemInterface.h"
-#include "NiagaraFunctionLibrary.h" // Add this for Niagara
-#include "NiagaraComponent.h" // Add this too
-#include "Kismet/GameplayStatics.h"
+#include "NiagaraSystem.h"
+#include "NiagaraComponent.h"
+#include "Components/AudioComponent.h"
+#include "Sound/SoundBase.h"
 #include "../Character/WoWCharacterBase.h"
+#include "../Character/CombatantGridSubsystem.h"
+#include "../Abilities/Effects/CombatQueueSubsystem.h"
+#include "../Abilities/Effects/EffectFeedbackSubsystem.h"
+#include "../Abilities/Effects/PeriodicEffectSubsystem.h"
 #include "../Attributes/WoWAttributeSet.h"
 #include "GameplayEffect.h"
 #include "AbilitySystemGlobals.h"
+#include "GameplayCueManager.h"
+#include "../WoWGameplayTags.h"
+
+namespace
+{
+    const FGameplayTag& GetPersistentSlotTag(int32 Slot)
+    {
+        static const FGameplayTag SlotTags[] = {
+            WoWGameplayTags::GameplayCue_Effect_Persistent_Slot0,
+            WoWGameplayTags::GameplayCue_Effect_Persistent_Slot1,
+            WoWGameplayTags::GameplayCue_Effect_Persistent_Slot2,
+            WoWGameplayTags::GameplayCue_Effect_Persistent_Slot3,
+            WoWGameplayTags::GameplayCue_Effect_Persistent_Slot4,
+            WoWGameplayTags::GameplayCue_Effect_Persistent_Slot5,
+            WoWGameplayTags::GameplayCue_Effect_Persistent_Slot6,
+            WoWGameplayTags::GameplayCue_Effect_Persistent_Slot7
+        };
+        static_assert(UE_ARRAY_COUNT(SlotTags) == UEffectApplicationComponent::MaxPersistentFeedback, "One cue tag per persistent slot");
+        
+        return SlotTags[Slot];
+    }
+    
+    // The component holding TargetActor's persistent feedback slots
+    UEffectApplicationComponent* FindTargetEffectComponent(AActor* TargetActor)
+    {
+        AWoWCharacterBase* TargetCharacter = Cast<AWoWCharacterBase>(TargetActor);
+        return TargetCharacter 
+            ? TargetCharacter->GetEffectApplicationComponent() 
+            : (TargetActor ? TargetActor->FindComponentByClass<UEffectApplicationComponent>() : nullptr);
+    }
+    
+    // One area effect's applied targets while some of its targets still wait in the combat queue
+    struct FPendingAreaEffect
+    {
+        TArray<TWeakObjectPtr<AActor>> AppliedTargets;
+        int32 NumQueued = 0;
+    };
+    
+    // The table row a feedback cue refers to. Snapshot keeps the row alive while the caller uses it
+    const FEffectTableRow* FindCueEffectRow(const FGameplayCueParameters& Parameters, FEffectDataSnapshotPtr& OutSnapshot)
+    {
+        const UEffectDataAsset* EffectDataAsset = Cast<const UEffectDataAsset>(Parameters.SourceObject.Get());
+        OutSnapshot = EffectDataAsset ? EffectDataAsset->GetSnapshot() : FEffectDataSnapshotPtr();
+        
+        const FCompiledEffectRecord* Effect = OutSnapshot.IsValid() ? OutSnapshot->FindRecord(FMath::RoundToInt(Parameters.RawMagnitude)) : nullptr;
+        return Effect ? Effect->SourceRow : nullptr;
+    }
+}
 
 UEffectApplicationComponent::UEffectApplicationComponent()
 {
     PrimaryComponentTick.bCanEverTick = false;
     CachedEffectDataAsset = nullptr;
+    MaxAreaFeedbackTargets = 8;
 }
 
 void UEffectApplicationComponent::BeginPlay()
@@ -22,22 +78,56 @@ void UEffectApplicationComponent::BeginPlay()
     Super::BeginPlay();
 }
 
+void UEffectApplicationComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // Nothing persistent outlives its target
+    ReleaseAllPersistentSlots();
+    
+    if (UAbilitySystemComponent* OwnerASC = PersistentFeedbackASC.Get())
+    {
+        OwnerASC->RegisterGameplayTagEvent(WoWGameplayTags::State_Dead, EGameplayTagEventType::NewOrRemoved).Remove(DeadTagEventHandle);
+    }
+    PersistentFeedbackASC.Reset();
+    DeadTagEventHandle.Reset();
+    
+    for (int32 Slot = 0; Slot < MaxPersistentFeedback; ++Slot)
+    {
+        StopPersistentVisual(Slot);
+    }
+    
+    Super::EndPlay(EndPlayReason);
+}
+
+void UEffectApplicationComponent::SetEffectDataAsset(UEffectDataAsset* NewDataAsset)
+{
+    // The table's assets started streaming with the map (UCombatDataPreloadSubsystem)
+    CachedEffectDataAsset = NewDataAsset;
+}
+
 FActiveGameplayEffectHandle UEffectApplicationComponent::ApplyEffectToTarget(int32 EffectID, AActor* TargetActor, float Level)
+{
+    FActiveGameplayEffectHandle ActiveHandle;
+    ApplyEffectToTargetInternal(EffectID, TargetActor, Level, ActiveHandle);
+    return ActiveHandle;
+}
+
+bool UEffectApplicationComponent::ApplyEffectToTargetInternal(int32 EffectID, AActor* TargetActor, float Level, FActiveGameplayEffectHandle& OutHandle)
 {
     if (!CachedEffectDataAsset || !TargetActor)
     {
         UE_LOG(LogTemp, Warning, TEXT("ApplyEffectToTarget: Missing data asset or target"));
         OnEffectApplied.Broadcast(EffectID, TargetActor, false);
-        return FActiveGameplayEffectHandle();
+        return false;
     }
     
-    // Get the effect data
-    FEffectTableRow EffectData;
-    if (!CachedEffectDataAsset->GetEffectDataByID(EffectID, EffectData))
+    // Hold the snapshot for the whole apply so a live rebalance cannot swap the record out from under us
+    FEffectDataSnapshotPtr EffectSnapshot = CachedEffectDataAsset->GetSnapshot();
+    const FCompiledEffectRecord* Effect = EffectSnapshot.IsValid() ? EffectSnapshot->FindRecord(EffectID) : nullptr;
+    if (!Effect || !Effect->SourceRow)
     {
         UE_LOG(LogTemp, Warning, TEXT("ApplyEffectToTarget: Effect ID %d not found"), EffectID);
         OnEffectApplied.Broadcast(EffectID, TargetActor, false);
-        return FActiveGameplayEffectHandle();
+        return false;
     }
     
     // Get the ASC from the target
@@ -46,7 +136,7 @@ FActiveGameplayEffectHandle UEffectApplicationComponent::ApplyEffectToTarget(int
     {
         UE_LOG(LogTemp, Warning, TEXT("ApplyEffectToTarget: Target has no AbilitySystemComponent"));
         OnEffectApplied.Broadcast(EffectID, TargetActor, false);
-        return FActiveGameplayEffectHandle();
+        return false;
     }
     
     // Get the source actor (owner of this component)
@@ -55,76 +145,102 @@ FActiveGameplayEffectHandle UEffectApplicationComponent::ApplyEffectToTarget(int
     {
         UE_LOG(LogTemp, Warning, TEXT("ApplyEffectToTarget: No source actor"));
         OnEffectApplied.Broadcast(EffectID, TargetActor, false);
-        return FActiveGameplayEffectHandle();
+        return false;
     }
     
-    // Check tags on the target
-    if (EffectData.RequiredTargetTags.Num() > 0)
+    const FEffectTableRow& EffectData = *Effect->SourceRow;
+    
+    // Check tags on the target against its tag counts, nothing is copied
+    if (Effect->HasFlag(EEffectRecordFlags::HasRequiredTags) && !Effect->TargetRequirements.HasRequiredTags(*TargetASC))
     {
-        FGameplayTagContainer TargetTags;
-        TargetASC->GetOwnedGameplayTags(TargetTags);
-        
-        if (!TargetTags.HasAll(EffectData.RequiredTargetTags))
-        {
-            // Missing required tags
-            UE_LOG(LogTemp, Warning, TEXT("ApplyEffectToTarget: Target missing required tags"));
-            OnEffectApplied.Broadcast(EffectID, TargetActor, false);
-            return FActiveGameplayEffectHandle();
-        }
+        // Missing required tags
+        UE_LOG(LogTemp, Warning, TEXT("ApplyEffectToTarget: Target missing required tags"));
+        OnEffectApplied.Broadcast(EffectID, TargetActor, false);
+        return false;
     }
     
-    if (EffectData.ForbiddenTargetTags.Num() > 0)
+    if (Effect->HasFlag(EEffectRecordFlags::HasForbiddenTags) && Effect->TargetRequirements.HasForbiddenTags(*TargetASC))
     {
-        FGameplayTagContainer TargetTags;
-        TargetASC->GetOwnedGameplayTags(TargetTags);
-        
-        if (TargetTags.HasAny(EffectData.ForbiddenTargetTags))
-        {
-            // Has forbidden tags
-            UE_LOG(LogTemp, Warning, TEXT("ApplyEffectToTarget: Target has forbidden tags"));
-            OnEffectApplied.Broadcast(EffectID, TargetActor, false);
-            return FActiveGameplayEffectHandle();
-        }
+        // Has forbidden tags
+        UE_LOG(LogTemp, Warning, TEXT("ApplyEffectToTarget: Target has forbidden tags"));
+        OnEffectApplied.Broadcast(EffectID, TargetActor, false);
+        return false;
     }
     
-    // Get the GE class
-    UClass* GEClass = EffectData.GameplayEffectClass.LoadSynchronous();
-    if (!GEClass)
+    // Fast path is an already-resolved class; if it is still streaming, report it instead of blocking
+    const UGameplayEffect* EffectCDO = CachedEffectDataAsset->TryResolveEffectClass(*Effect);
+    if (!EffectCDO)
     {
-        UE_LOG(LogTemp, Warning, TEXT("ApplyEffectToTarget: GameplayEffect class not found for effect ID %d"), EffectID);
+        if (EffectData.GameplayEffectClass.IsNull())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ApplyEffectToTarget: GameplayEffect class not set for effect ID %d"), EffectID);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ApplyEffectToTarget: GameplayEffect class for effect ID %d is still loading"), EffectID);
+        }
+        
         OnEffectApplied.Broadcast(EffectID, TargetActor, false);
-        return FActiveGameplayEffectHandle();
+        return false;
     }
     
     // Calculate magnitude
-    float Magnitude = CalculateEffectMagnitude(EffectData, SourceActor, TargetActor, Level);
+    float Magnitude = CalculateRecordMagnitude(*Effect, SourceActor, TargetActor, Level);
     
     // Create the effect spec
-    FGameplayEffectSpecHandle SpecHandle = CreateEffectSpec(EffectData, SourceActor, TargetActor, Level, Magnitude);
+    FGameplayEffectSpecHandle SpecHandle = CreateEffectSpec(*Effect, EffectCDO, SourceActor, Level, Magnitude);
     
     if (!SpecHandle.IsValid())
     {
         UE_LOG(LogTemp, Warning, TEXT("ApplyEffectToTarget: Failed to create valid effect spec"));
         OnEffectApplied.Broadcast(EffectID, TargetActor, false);
-        return FActiveGameplayEffectHandle();
+        return false;
     }
     
-    // Apply the effect
-    FActiveGameplayEffectHandle ActiveHandle = TargetASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
+    // DoT/HoT ticks belong to the periodic scheduler, instant effects go through the frame's combat queue
+    // on the server, and durations need their handle now
+    FActiveGameplayEffectHandle ActiveHandle;
+    const FPeriodicEffectHandle PeriodicHandle = SchedulePeriodicEffect(*Effect, TargetASC, *SpecHandle.Data.Get());
+    const bool bScheduled = PeriodicHandle.IsValid();
+    bool bQueued = false;
+    if (!bScheduled && !Effect->HasFlag(EEffectRecordFlags::HasDuration))
+    {
+        // A queued effect is reported once the flush has actually applied it
+        UCombatQueueSubsystem* CombatQueue = UCombatQueueSubsystem::Get(this);
+        bQueued = CombatQueue && CombatQueue->EnqueueSpec(TargetASC, SpecHandle, Effect->SetByCallerTag,
+            FOnQueuedEffectApplied::CreateWeakLambda(this, [this, EffectID, WeakTarget = TWeakObjectPtr<AActor>(TargetActor)](bool bApplied)
+            {
+                OnEffectApplied.Broadcast(EffectID, WeakTarget.Get(), bApplied);
+            }));
+    }
     
-    // Play application feedback
-    PlayEffectFeedback(EffectData, TargetActor, false);
+    if (!bScheduled && !bQueued)
+    {
+        ActiveHandle = TargetASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
+    }
+    
+    // Feedback goes out as cues, so it reaches the clients the target is relevant to and the server plays nothing
+    SendFeedbackCue(TargetASC, WoWGameplayTags::GameplayCue_Effect_Applied, EffectID);
     
-    // If it's a duration effect, also play persistent feedback
-    if (EffectData.DurationType == EEffectDurationType::Duration)
+    // If it's a duration effect, also show persistent feedback for as long as the effect is active
+    if (Effect->HasFlag(EEffectRecordFlags::HasDuration) && ActiveHandle.IsValid())
+    {
+        AddPersistentFeedbackToTarget(TargetActor, TargetASC, ActiveHandle, EffectID);
+    }
+    else if (bScheduled)
     {
-        PlayEffectFeedback(EffectData, TargetActor, true);
+        AddPersistentFeedbackToTarget(TargetActor, TargetASC, PeriodicHandle, EffectID);
     }
     
-    // Broadcast the event
-    OnEffectApplied.Broadcast(EffectID, TargetActor, ActiveHandle.IsValid());
+    const bool bApplied = bScheduled || ActiveHandle.WasSuccessfullyApplied();
+    if (!bQueued)
+    {
+        // A scheduled effect counts as applied
+        OnEffectApplied.Broadcast(EffectID, TargetActor, bApplied);
+    }
     
-    return ActiveHandle;
+    OutHandle = ActiveHandle;
+    return bApplied || bQueued;
 }
 
 bool UEffectApplicationComponent::ApplyEffectsToTarget(const TArray<int32>& EffectIDs, AActor* TargetActor, float Level)
@@ -134,11 +250,14 @@ bool UEffectApplicationComponent::ApplyEffectsToTarget(const TArray<int32>& Effe
         return false;
     }
     
+    // Send every effect's cues in one batch
+    FScopedGameplayCueSendContext GameplayCueSendContext;
+    
     bool Success = true;
     for (int32 EffectID : EffectIDs)
     {
-        FActiveGameplayEffectHandle Handle = ApplyEffectToTarget(EffectID, TargetActor, Level);
-        if (!Handle.IsValid())
+        FActiveGameplayEffectHandle Handle;
+        if (!ApplyEffectToTargetInternal(EffectID, TargetActor, Level, Handle))
         {
             Success = false;
         }
@@ -159,30 +278,222 @@ int32 UEffectApplicationComponent::ApplyAreaEffects(const TArray<int32>& EffectI
         return 0;
     }
     
-    // Get all actors in range
-    TArray<AActor*> OverlappingActors;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), AActor::StaticClass(), OverlappingActors);
+    // Only characters can receive effects, so ask the combatant grid instead of scanning every actor
+    UCombatantGridSubsystem* CombatantGrid = UCombatantGridSubsystem::Get(this);
+    if (!CombatantGrid)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ApplyAreaEffects: No combatant grid in this world"));
+        return 0;
+    }
+    
+    AActor* SourceActor = GetOwner();
+    if (!CachedEffectDataAsset || !SourceActor)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ApplyAreaEffects: Missing data asset or source actor"));
+        return 0;
+    }
+    
+    const FVector Center = CenterActor->GetActorLocation();
+    
+    TArray<AWoWCharacterBase*> TargetsInRange;
+    CombatantGrid->QueryRadius(Center, Radius, ECombatFaction::All, TargetsInRange, CenterActor);
+    
+    // Resolve every target's ASC once for all effects
+    TArray<AActor*, TInlineAllocator<32>> Targets;
+    TArray<UAbilitySystemComponent*, TInlineAllocator<32>> TargetASCs;
+    Targets.Reserve(TargetsInRange.Num());
+    TargetASCs.Reserve(TargetsInRange.Num());
+    for (AWoWCharacterBase* Target : TargetsInRange)
+    {
+        if (UAbilitySystemComponent* TargetASC = GetAbilitySystemComponent(Target))
+        {
+            Targets.Add(Target);
+            TargetASCs.Add(TargetASC);
+        }
+    }
+    
+    if (Targets.Num() == 0)
+    {
+        return 0;
+    }
+    
+    // One snapshot for the whole batch, same as a single apply
+    FEffectDataSnapshotPtr EffectSnapshot = CachedEffectDataAsset->GetSnapshot();
+    if (!EffectSnapshot.IsValid())
+    {
+        return 0;
+    }
     
-    const FVector CenterLocation = CenterActor->GetActorLocation();
-    int32 SuccessCount = 0;
+    TBitArray<> TargetHit(false, Targets.Num());
     
-    // Filter by distance and apply effects
-    for (AActor* Actor : OverlappingActors)
+    // Send every effect's cues in one batch
+    FScopedGameplayCueSendContext GameplayCueSendContext;
+    
+    TArray<int32> PassingIndices;
+    TArray<AActor*> PassingTargets;
+    TArray<float> Magnitudes;
+    TArray<int32> HitIndices;
+    
+    for (int32 EffectID : EffectIDs)
     {
-        if (Actor != CenterActor && Actor)
+        const FCompiledEffectRecord* Effect = EffectSnapshot->FindRecord(EffectID);
+        if (!Effect || !Effect->SourceRow)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ApplyAreaEffects: Effect ID %d not found"), EffectID);
+            continue;
+        }
+        
+        const UGameplayEffect* EffectCDO = CachedEffectDataAsset->TryResolveEffectClass(*Effect);
+        if (!EffectCDO)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ApplyAreaEffects: GameplayEffect class for effect ID %d is not set or still loading"), EffectID);
+            continue;
+        }
+        
+        // Tag requirements against every target in one sweep
+        PassingIndices.Reset();
+        Effect->TargetRequirements.FilterTargets(TargetASCs, PassingIndices);
+        if (PassingIndices.Num() == 0)
+        {
+            continue;
+        }
+        
+        PassingTargets.Reset();
+        for (int32 TargetIndex : PassingIndices)
         {
-            float Distance = FVector::Dist(CenterLocation, Actor->GetActorLocation());
-            if (Distance <= Radius)
+            PassingTargets.Add(Targets[TargetIndex]);
+        }
+        
+        // Source stats are read once; only formulas that read the target evaluate per target
+        CalculateRecordMagnitudes(*Effect, SourceActor, PassingTargets, Level, Magnitudes);
+        
+        FGameplayEffectSpecHandle SpecHandle = CreateEffectSpec(*Effect, EffectCDO, SourceActor, Level, Magnitudes[0]);
+        if (!SpecHandle.IsValid())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ApplyAreaEffects: Failed to create valid effect spec for effect ID %d"), EffectID);
+            continue;
+        }
+        
+        FGameplayEffectSpec& Spec = *SpecHandle.Data.Get();
+        const bool bNegate = Effect->HasFlag(EEffectRecordFlags::NegateMagnitude);
+        const bool bHasDuration = Effect->HasFlag(EEffectRecordFlags::HasDuration);
+        float SpecMagnitude = Magnitudes[0];
+        
+        // Instant effects go through the frame's combat queue like single-target ones
+        UCombatQueueSubsystem* CombatQueue = bHasDuration ? nullptr : UCombatQueueSubsystem::Get(this);
+        TSharedRef<FPendingAreaEffect> PendingArea = MakeShared<FPendingAreaEffect>();
+        
+        HitIndices.Reset();
+        for (int32 PassIndex = 0; PassIndex < PassingIndices.Num(); ++PassIndex)
+        {
+            // The spec is copied on apply, so only the SetByCaller value changes between targets
+            if (Magnitudes[PassIndex] != SpecMagnitude && Effect->SetByCallerTag.IsValid())
             {
-                if (ApplyEffectsToTarget(EffectIDs, Actor, Level))
+                SpecMagnitude = Magnitudes[PassIndex];
+                Spec.SetSetByCallerMagnitude(Effect->SetByCallerTag, bNegate ? -SpecMagnitude : SpecMagnitude);
+            }
+            
+            const int32 TargetIndex = PassingIndices[PassIndex];
+            UAbilitySystemComponent* TargetASC = TargetASCs[TargetIndex];
+            
+            const FPeriodicEffectHandle PeriodicHandle = SchedulePeriodicEffect(*Effect, TargetASC, Spec);
+            bool bApplied = PeriodicHandle.IsValid();
+            bool bQueued = false;
+            
+            // Persistent feedback follows the same cap as the application cues below
+            if (bApplied && HitIndices.Num() < MaxAreaFeedbackTargets)
+            {
+                AddPersistentFeedbackToTarget(Targets[TargetIndex], TargetASC, PeriodicHandle, EffectID);
+            }
+
+            if (!bApplied && CombatQueue)
+            {
+                // The queue holds on to its spec until the flush, so every target gets its own copy
+                FGameplayEffectSpecHandle TargetSpec(new FGameplayEffectSpec(Spec));
+                bQueued = CombatQueue->EnqueueSpec(TargetASC, TargetSpec, Effect->SetByCallerTag,
+                    FOnQueuedEffectApplied::CreateWeakLambda(this, [this, EffectID, PendingArea, WeakTarget = TWeakObjectPtr<AActor>(Targets[TargetIndex])](bool bTargetApplied)
+                    {
+                        if (bTargetApplied)
+                        {
+                            PendingArea->AppliedTargets.Add(WeakTarget);
+                        }
+                        
+                        if (--PendingArea->NumQueued == 0)
+                        {
+                            BroadcastAreaEffect(EffectID, PendingArea->AppliedTargets);
+                        }
+                    }));
+                
+                if (bQueued)
+                {
+                    ++PendingArea->NumQueued;
+                }
+            }
+            
+            if (!bApplied && !bQueued)
+            {
+                // Instant effects never get a valid handle, only a successfully-applied one
+                const FActiveGameplayEffectHandle ActiveHandle = TargetASC->ApplyGameplayEffectSpecToSelf(Spec);
+                bApplied = ActiveHandle.WasSuccessfullyApplied();
+                
+                // Persistent feedback follows the same cap as the application cues below
+                if (bHasDuration && ActiveHandle.IsValid() && HitIndices.Num() < MaxAreaFeedbackTargets)
                 {
-                    SuccessCount++;
+                    AddPersistentFeedbackToTarget(Targets[TargetIndex], TargetASC, ActiveHandle, EffectID);
                 }
             }
+            
+            if (bApplied || bQueued)
+            {
+                TargetHit[TargetIndex] = true;
+                HitIndices.Add(TargetIndex);
+            }
+            
+            if (bApplied)
+            {
+                PendingArea->AppliedTargets.Add(Targets[TargetIndex]);
+            }
+        }
+        
+        if (HitIndices.Num() == 0)
+        {
+            continue;
+        }
+        
+        // Capped feedback: the first target carries the sound, the rest only their VFX
+        const int32 NumFeedbackTargets = FMath::Min(HitIndices.Num(), FMath::Max(MaxAreaFeedbackTargets, 0));
+        for (int32 HitIndex = 0; HitIndex < NumFeedbackTargets; ++HitIndex)
+        {
+            SendFeedbackCue(TargetASCs[HitIndices[HitIndex]], 
+                HitIndex == 0 ? WoWGameplayTags::GameplayCue_Effect_Applied : WoWGameplayTags::GameplayCue_Effect_Applied_Visual, EffectID);
+        }
+        
+        // With targets still in the queue, the last one to be applied broadcasts for all of them
+        if (PendingArea->NumQueued == 0)
+        {
+            BroadcastAreaEffect(EffectID, PendingArea->AppliedTargets);
         }
     }
     
-    return SuccessCount;
+    return TargetHit.CountSetBits();
+}
+
+void UEffectApplicationComponent::BroadcastAreaEffect(int32 EffectID, const TArray<TWeakObjectPtr<AActor>>& AppliedTargets)
+{
+    TArray<AActor*> Targets;
+    Targets.Reserve(AppliedTargets.Num());
+    for (const TWeakObjectPtr<AActor>& WeakTarget : AppliedTargets)
+    {
+        if (AActor* Target = WeakTarget.Get())
+        {
+            Targets.Add(Target);
+        }
+    }
+    
+    if (Targets.Num() > 0)
+    {
+        OnAreaEffectApplied.Broadcast(EffectID, Targets);
+    }
 }
 
 float UEffectApplicationComponent::CalculateEffectMagnitude(const FEffectTableRow& EffectData, AActor* SourceActor, AActor* TargetActor, float Level)
@@ -205,18 +516,105 @@ float UEffectApplicationComponent::CalculateEffectMagnitude(const FEffectTableRo
             break;
             
         case EEffectMagnitudeType::ScaledByLevel:
-            Result += (Level * ScalingInfo.ScalingCoefficient);
+        {
+            // A row with a level curve reads it from the compiled record's baked table
+            const FCompiledEffectRecord* Record = !ScalingInfo.LevelCurve.IsNone() && CachedEffectDataAsset 
+                ? CachedEffectDataAsset->FindCompiledEffect(EffectData.EffectID) : nullptr;
+            const float LevelValue = Record && Record->Magnitude.LevelCurve.IsValid() ? Record->Magnitude.LevelCurve->GetValue(Level) : Level;
+            Result += (LevelValue * ScalingInfo.ScalingCoefficient);
+            break;
+        }
+            
+        case EEffectMagnitudeType::Custom:
+            // Use the formula compiled for this row when the table was indexed
+            if (CachedEffectDataAsset)
+            {
+                const FCompiledEffectRecord* Record = CachedEffectDataAsset->FindCompiledEffect(EffectData.EffectID);
+                if (Record && Record->Magnitude.Formula.IsValid())
+                {
+                    Result = Record->Magnitude.Formula->Evaluate(Level, GetAbilitySystemComponent(SourceActor), GetAbilitySystemComponent(TargetActor));
+                }
+            }
+            break;
+    }
+    
+    return Result;
+}
+
+float UEffectApplicationComponent::EvaluateMagnitude(const FCompiledEffectMagnitude& Magnitude, AActor* SourceActor, AActor* TargetActor, float Level) const
+{
+    float Result = Magnitude.BaseValue;
+    
+    switch (Magnitude.MagnitudeType)
+    {
+        case EEffectMagnitudeType::Flat:
+            break;
+            
+        case EEffectMagnitudeType::ScaledByStat:
+            if (SourceActor && Magnitude.StatAttribute.IsValid())
+            {
+                Result += GetStatValue(SourceActor, Magnitude.StatAttribute) * Magnitude.ScalingCoefficient;
+            }
+            break;
+            
+        case EEffectMagnitudeType::ScaledByLevel:
+            Result += (Magnitude.LevelCurve.IsValid() ? Magnitude.LevelCurve->GetValue(Level) : Level) * Magnitude.ScalingCoefficient;
             break;
             
         case EEffectMagnitudeType::Custom:
-            // Custom formulas would need to be implemented in a subclass
-            // For now we'll just use the base value
+            // A formula that failed to compile falls back to the base value
+            if (Magnitude.Formula.IsValid())
+            {
+                Result = Magnitude.Formula->Evaluate(Level, GetAbilitySystemComponent(SourceActor), GetAbilitySystemComponent(TargetActor));
+            }
             break;
     }
     
     return Result;
 }
 
+float UEffectApplicationComponent::CalculateRecordMagnitude(const FCompiledEffectRecord& Effect, AActor* SourceActor, AActor* TargetActor, float Level) const
+{
+    return EvaluateMagnitude(Effect.Magnitude, SourceActor, TargetActor, Level);
+}
+
+float UEffectApplicationComponent::CalculateAdditionalMagnitude(const FCompiledEffectRecord& Effect, int32 MagnitudeIndex, AActor* SourceActor, AActor* TargetActor, float Level) const
+{
+    const FCompiledEffectMagnitude* Magnitude = Effect.FindAdditionalMagnitude(MagnitudeIndex);
+    return Magnitude ? EvaluateMagnitude(*Magnitude, SourceActor, TargetActor, Level) : 0.0f;
+}
+
+void UEffectApplicationComponent::CalculateRecordMagnitudes(const FCompiledEffectRecord& Effect, AActor* SourceActor, TArrayView<AActor* const> TargetActors, float Level, TArray<float>& OutMagnitudes) const
+{
+    OutMagnitudes.SetNumUninitialized(TargetActors.Num());
+    
+    if (TargetActors.Num() == 0)
+    {
+        return;
+    }
+    
+    // Only custom formulas can depend on the target
+    const FCompiledEffectMagnitude& Magnitude = Effect.Magnitude;
+    if (Magnitude.MagnitudeType != EEffectMagnitudeType::Custom || !Magnitude.Formula.IsValid() || !Magnitude.Formula->ReadsTarget())
+    {
+        const float Value = CalculateRecordMagnitude(Effect, SourceActor, TargetActors[0], Level);
+        for (float& OutMagnitude : OutMagnitudes)
+        {
+            OutMagnitude = Value;
+        }
+        return;
+    }
+    
+    TArray<const UAbilitySystemComponent*, TInlineAllocator<32>> TargetASCs;
+    TargetASCs.Reserve(TargetActors.Num());
+    for (AActor* TargetActor : TargetActors)
+    {
+        TargetASCs.Add(GetAbilitySystemComponent(TargetActor));
+    }
+    
+    Magnitude.Formula->EvaluateBatch(Level, GetAbilitySystemComponent(SourceActor), TargetASCs, OutMagnitudes);
+}
+
 UAbilitySystemComponent* UEffectApplicationComponent::GetAbilitySystemComponent(AActor* Actor) const
 {
     if (!Actor)
@@ -235,205 +633,441 @@ UAbilitySystemComponent* UEffectApplicationComponent::GetAbilitySystemComponent(
     return Actor->FindComponentByClass<UAbilitySystemComponent>();
 }
 
-void UEffectApplicationComponent::PlayEffectFeedback(const FEffectTableRow& EffectData, AActor* TargetActor, bool IsPersistent)
+void UEffectApplicationComponent::PlayEffectFeedback(const FEffectTableRow& EffectData, AActor* TargetActor, const AActor* InstigatorActor, bool bPlaySound)
 {
-    if (!TargetActor)
+    // Nobody is watching on a dedicated server
+    if (!TargetActor || GetNetMode() == NM_DedicatedServer)
     {
         return;
     }
     
+    // Pooled playback with the frame budget, distance cull and per-effect cap
+    UEffectFeedbackSubsystem* FeedbackPlayer = UEffectFeedbackSubsystem::Get(this);
+    if (!FeedbackPlayer)
+    {
+        return;
+    }
+    
+    // Cosmetics are streamed by the data asset preload; anything still loading is skipped rather than loaded here
+    
     // Play VFX
-    UNiagaraSystem* VFX = nullptr;
-    if (IsPersistent)
+    if (UNiagaraSystem* VFX = EffectData.ApplicationVFX.Get())
     {
-        VFX = EffectData.PersistentVFX.LoadSynchronous();
+        FeedbackPlayer->PlayAttached(VFX, TargetActor, EffectData.EffectID, InstigatorActor);
     }
-    else
+    
+    // Play sound
+    USoundBase* Sound = EffectData.ApplicationSound.Get();
+    if (Sound && bPlaySound)
     {
-        VFX = EffectData.ApplicationVFX.LoadSynchronous();
+        FeedbackPlayer->PlaySoundAt(Sound, TargetActor->GetActorLocation(), TargetActor, InstigatorActor);
     }
+}
+
+void UEffectApplicationComponent::SendFeedbackCue(UAbilitySystemComponent* TargetASC, const FGameplayTag& CueTag, int32 EffectID)
+{
+    if (!TargetASC || !CachedEffectDataAsset)
+    {
+        return;
+    }
+    
+    // Clients look the row up in the same table. The cue has no magnitude of its own, so RawMagnitude carries the effect ID
+    FGameplayCueParameters Parameters;
+    Parameters.Instigator = GetOwner();
+    Parameters.EffectCauser = GetOwner();
+    Parameters.SourceObject = CachedEffectDataAsset;
+    Parameters.RawMagnitude = static_cast<float>(EffectID);
     
-    if (VFX)
+    // With the caster's prediction key a predicting client plays the cue right away and skips the server's copy
+    UAbilitySystemComponent* SourceASC = GetAbilitySystemComponent(GetOwner());
+    const FPredictionKey PredictionKey = SourceASC ? SourceASC->ScopedPredictionKey : FPredictionKey();
+    
+    UAbilitySystemGlobals::Get().GetGameplayCueManager()->InvokeGameplayCueExecuted_WithParams(TargetASC, CueTag, PredictionKey, Parameters);
+}
+
+bool UEffectApplicationComponent::HandleFeedbackCue(const FGameplayTag& CueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters)
+{
+    // Persistent slots follow the cue's lifetime. WhileActive also fires for clients that only just saw the target
+    const int32 PersistentSlot = GetPersistentSlot(CueTag);
+    if (PersistentSlot != INDEX_NONE)
     {
-        UNiagaraFunctionLibrary::SpawnSystemAttached(
-            VFX,
-            TargetActor->GetRootComponent(),
-            NAME_None,
-            FVector::ZeroVector,
-            FRotator::ZeroRotator,
-            EAttachLocation::SnapToTarget,
-            true
-        );
+        if (EventType == EGameplayCueEvent::WhileActive)
+        {
+            StartPersistentVisual(PersistentSlot, Parameters);
+        }
+        else if (EventType == EGameplayCueEvent::Removed)
+        {
+            StopPersistentVisual(PersistentSlot);
+        }
+        return true;
     }
     
-    // Play sound
-    USoundBase* Sound = nullptr;
-    if (IsPersistent)
+    if (!CueTag.MatchesTag(WoWGameplayTags::GameplayCue_Effect_Applied))
     {
-        Sound = EffectData.PersistentSound.LoadSynchronous();
+        return false;
     }
-    else
+    
+    // Application cues are only ever executed
+    if (EventType != EGameplayCueEvent::Executed)
     {
-        Sound = EffectData.ApplicationSound.LoadSynchronous();
+        return true;
     }
     
-    if (Sound)
+    FEffectDataSnapshotPtr EffectSnapshot;
+    if (const FEffectTableRow* EffectData = FindCueEffectRow(Parameters, EffectSnapshot))
     {
-        UGameplayStatics::PlaySoundAtLocation(
-            GetWorld(),
-            Sound,
-            TargetActor->GetActorLocation()
-        );
+        const bool bPlaySound = CueTag != WoWGameplayTags::GameplayCue_Effect_Applied_Visual;
+        PlayEffectFeedback(*EffectData, GetOwner(), Parameters.Instigator.Get(), bPlaySound);
     }
+    
+    return true;
 }
 
-float UEffectApplicationComponent::GetStatValue(AActor* Actor, const FGameplayTag& StatTag) const
+int32 UEffectApplicationComponent::GetPersistentSlot(const FGameplayTag& CueTag)
 {
-    if (!Actor || !StatTag.IsValid())
+    if (!CueTag.MatchesTag(WoWGameplayTags::GameplayCue_Effect_Persistent))
     {
-        return 0.0f;
+        return INDEX_NONE;
     }
     
-    // Try to get the character
-    AWoWCharacterBase* Character = Cast<AWoWCharacterBase>(Actor);
-    if (!Character)
+    for (int32 Slot = 0; Slot < MaxPersistentFeedback; ++Slot)
     {
-        return 0.0f;
+        if (CueTag == GetPersistentSlotTag(Slot))
+        {
+            return Slot;
+        }
     }
     
-    // Get the attribute set
-    UWoWAttributeSet* AttributeSet = Character->GetAttributeSet();
-    if (!AttributeSet)
+    return INDEX_NONE;
+}
+
+FPeriodicEffectHandle UEffectApplicationComponent::SchedulePeriodicEffect(const FCompiledEffectRecord& Effect, UAbilitySystemComponent* TargetASC, const FGameplayEffectSpec& TickSpec) const
+{
+    // A timed DoT/HoT row whose effect class is one tick. Classes with their own period keep ticking through GAS
+    if (!Effect.HasFlag(EEffectRecordFlags::Periodic) || !Effect.HasFlag(EEffectRecordFlags::HasDuration)
+        || (Effect.EffectType != EEffectType::DamageOverTime && Effect.EffectType != EEffectType::HealingOverTime)
+        || TickSpec.Def->DurationPolicy != EGameplayEffectDurationType::Instant)
     {
-        return 0.0f;
+        return FPeriodicEffectHandle();
     }
     
-    // Map the tag to an attribute
-    FString TagString = StatTag.ToString();
-    
-    // Check for primary attributes
-    if (TagString.Contains("Attribute.Primary.Strength"))
-    {
-        return AttributeSet->GetStrength();
-    }
-    else if (TagString.Contains("Attribute.Primary.Agility"))
+    UPeriodicEffectSubsystem* PeriodicScheduler = UPeriodicEffectSubsystem::Get(this);
+    if (!PeriodicScheduler)
     {
-        return AttributeSet->GetAgility();
+        return FPeriodicEffectHandle();
     }
-    else if (TagString.Contains("Attribute.Primary.Intellect"))
+    
+    // The row's period is used as authored, the same as the GAS timer it replaces
+    return PeriodicScheduler->ScheduleEffect(TargetASC, TickSpec, Effect.EffectID, Effect.SetByCallerTag, Effect.TickPeriod, Effect.Duration);
+}
+
+void UEffectApplicationComponent::AddPersistentFeedbackToTarget(AActor* TargetActor, UAbilitySystemComponent* TargetASC, FActiveGameplayEffectHandle ActiveHandle, int32 EffectID)
+{
+    // The slots live on the target, so they are torn down with it
+    if (UEffectApplicationComponent* TargetEffects = FindTargetEffectComponent(TargetActor))
     {
-        return AttributeSet->GetIntellect();
+        TargetEffects->AddPersistentFeedback(TargetASC, ActiveHandle, EffectID, GetOwner(), CachedEffectDataAsset);
     }
-    else if (TagString.Contains("Attribute.Primary.Stamina"))
+}
+
+void UEffectApplicationComponent::AddPersistentFeedbackToTarget(AActor* TargetActor, UAbilitySystemComponent* TargetASC, FPeriodicEffectHandle PeriodicHandle, int32 EffectID)
+{
+    if (UEffectApplicationComponent* TargetEffects = FindTargetEffectComponent(TargetActor))
     {
-        return AttributeSet->GetStamina();
+        TargetEffects->AddPersistentFeedback(TargetASC, PeriodicHandle, EffectID, GetOwner(), CachedEffectDataAsset);
     }
-    else if (TagString.Contains("Attribute.Primary.Spirit"))
+}
+
+bool UEffectApplicationComponent::AddPersistentFeedback(UAbilitySystemComponent* OwnerASC, FActiveGameplayEffectHandle ActiveHandle, int32 EffectID, AActor* InstigatorActor, UEffectDataAsset* DataAsset)
+{
+    if (!OwnerASC || !ActiveHandle.IsValid() || !DataAsset)
     {
-        return AttributeSet->GetSpirit();
+        return false;
     }
     
-    // Check for secondary attributes
-    else if (TagString.Contains("Attribute.Secondary.Armor"))
+    const int32 FreeSlot = FindFreePersistentSlot(OwnerASC);
+    if (FreeSlot == INDEX_NONE)
     {
-        return AttributeSet->GetArmor();
+        return false;
     }
-    else if (TagString.Contains("Attribute.Secondary.CriticalStrikeChance"))
+    
+    // Null if the effect is already gone
+    FOnActiveGameplayEffectRemoved_Info* RemovedDelegate = OwnerASC->OnGameplayEffectRemoved_InfoDelegate(ActiveHandle);
+    if (!RemovedDelegate)
     {
-        return AttributeSet->GetCriticalStrikeChance();
+        return false;
     }
     
-    // Check for vital attributes
-    else if (TagString.Contains("Attribute.Vital.Health"))
+    RemovedDelegate->AddUObject(this, &UEffectApplicationComponent::OnPersistentEffectRemoved);
+    PersistentSlots[FreeSlot].ActiveHandle = ActiveHandle;
+    
+    AddPersistentSlotCue(FreeSlot, EffectID, InstigatorActor, DataAsset);
+    return true;
+}
+
+bool UEffectApplicationComponent::AddPersistentFeedback(UAbilitySystemComponent* OwnerASC, FPeriodicEffectHandle PeriodicHandle, int32 EffectID, AActor* InstigatorActor, UEffectDataAsset* DataAsset)
+{
+    UPeriodicEffectSubsystem* PeriodicScheduler = UPeriodicEffectSubsystem::Get(this);
+    if (!OwnerASC || !PeriodicHandle.IsValid() || !DataAsset || !PeriodicScheduler)
     {
-        return AttributeSet->GetHealth();
+        return false;
     }
-    else if (TagString.Contains("Attribute.Vital.MaxHealth"))
+    
+    // A refresh keeps its scheduler entry, and with it the slot it already has
+    for (const FPersistentSlot& PersistentSlot : PersistentSlots)
     {
-        return AttributeSet->GetMaxHealth();
+        if (PersistentSlot.PeriodicHandle == PeriodicHandle && PersistentFeedbackASC.Get() == OwnerASC)
+        {
+            return true;
+        }
     }
-    else if (TagString.Contains("Attribute.Vital.Mana"))
+    
+    const int32 FreeSlot = FindFreePersistentSlot(OwnerASC);
+    if (FreeSlot == INDEX_NONE)
     {
-        return AttributeSet->GetMana();
+        return false;
     }
-    else if (TagString.Contains("Attribute.Vital.MaxMana"))
+    
+    // Null if the entry already ended
+    FOnPeriodicEffectEnded* EndedDelegate = PeriodicScheduler->OnPeriodicEffectEnded(PeriodicHandle);
+    if (!EndedDelegate)
     {
-        return AttributeSet->GetMaxMana();
+        return false;
     }
     
-    return 0.0f;
+    EndedDelegate->AddUObject(this, &UEffectApplicationComponent::OnPersistentPeriodicEffectEnded);
+    PersistentSlots[FreeSlot].PeriodicHandle = PeriodicHandle;
+    
+    AddPersistentSlotCue(FreeSlot, EffectID, InstigatorActor, DataAsset);
+    return true;
 }
 
-FGameplayEffectSpecHandle UEffectApplicationComponent::CreateEffectSpec(const FEffectTableRow& EffectData, AActor* SourceActor, AActor* TargetActor, float Level, float CalculatedMagnitude)
+int32 UEffectApplicationComponent::FindFreePersistentSlot(UAbilitySystemComponent* OwnerASC)
 {
-    UClass* GEClass = EffectData.GameplayEffectClass.LoadSynchronous();
-    if (!GEClass || !SourceActor)
-    {
-        return FGameplayEffectSpecHandle();
-    }
-    
-    // Get source ASC
-    UAbilitySystemComponent* SourceASC = GetAbilitySystemComponent(SourceActor);
-    if (!SourceASC)
+    // Follow the owner's ASC; a new one (respawn, PlayerState swap) starts with empty slots
+    if (PersistentFeedbackASC.Get() != OwnerASC)
     {
-        // Fallback to creating a context without a source ASC
-        FGameplayEffectContextHandle EffectContext = FGameplayEffectContextHandle(UAbilitySystemGlobals::Get().AllocGameplayEffectContext());
-        EffectContext.AddSourceObject(SourceActor);
-        
-        // Create spec
-        FGameplayEffectSpecHandle SpecHandle = FGameplayEffectSpecHandle(new FGameplayEffectSpec(GEClass->GetDefaultObject<UGameplayEffect>(), EffectContext, Level));
+        ReleaseAllPersistentSlots();
         
-        // Handle damage effects
-        if (EffectData.EffectType == EEffectType::Damage || EffectData.EffectType == EEffectType::DamageOverTime)
-        {
-            FGameplayTag DamageTag = FGameplayTag::RequestGameplayTag(FName("Data.Damage"));
-            SpecHandle.Data->SetSetByCallerMagnitude(DamageTag, -CalculatedMagnitude);
-            UE_LOG(LogTemp, Warning, TEXT("Setting damage magnitude to %.2f"), -CalculatedMagnitude);
-        }
-        // Handle healing effects
-        else if (EffectData.EffectType == EEffectType::Healing || EffectData.EffectType == EEffectType::HealingOverTime)
+        if (UAbilitySystemComponent* OldASC = PersistentFeedbackASC.Get())
         {
-            FGameplayTag HealingTag = FGameplayTag::RequestGameplayTag(FName("Data.Healing"));
-            SpecHandle.Data->SetSetByCallerMagnitude(HealingTag, CalculatedMagnitude);
-        }
-        // Other effects use generic magnitude tag
-        else 
-        {
-            FGameplayTag MagnitudeTag = FGameplayTag::RequestGameplayTag(FName("Data.Magnitude"));
-            SpecHandle.Data->SetSetByCallerMagnitude(MagnitudeTag, CalculatedMagnitude);
+            OldASC->RegisterGameplayTagEvent(WoWGameplayTags::State_Dead, EGameplayTagEventType::NewOrRemoved).Remove(DeadTagEventHandle);
         }
         
-        return SpecHandle;
+        PersistentFeedbackASC = OwnerASC;
+        DeadTagEventHandle = OwnerASC->RegisterGameplayTagEvent(WoWGameplayTags::State_Dead, EGameplayTagEventType::NewOrRemoved)
+            .AddUObject(this, &UEffectApplicationComponent::OnOwnerDeadTagChanged);
     }
     
-    // Create effect context with source ASC
-    FGameplayEffectContextHandle EffectContext = SourceASC->MakeEffectContext();
-    EffectContext.AddSourceObject(SourceActor);
+    if (OwnerASC->HasMatchingGameplayTag(WoWGameplayTags::State_Dead))
+    {
+        return INDEX_NONE;
+    }
     
-    // Create spec
-    FGameplayEffectSpecHandle SpecHandle = SourceASC->MakeOutgoingSpec(GEClass, Level, EffectContext);
-    if (SpecHandle.IsValid())
+    for (int32 Slot = 0; Slot < MaxPersistentFeedback; ++Slot)
     {
-        // Handle damage effects
-        if (EffectData.EffectType == EEffectType::Damage || EffectData.EffectType == EEffectType::DamageOverTime)
+        if (PersistentSlots[Slot].IsFree())
         {
-            FGameplayTag DamageTag = FGameplayTag::RequestGameplayTag(FName("Data.Damage"));
-            SpecHandle.Data->SetSetByCallerMagnitude(DamageTag, -CalculatedMagnitude);
-            UE_LOG(LogTemp, Warning, TEXT("Setting damage magnitude to %.2f"), -CalculatedMagnitude);
+            return Slot;
         }
-        // Handle healing effects
-        else if (EffectData.EffectType == EEffectType::Healing || EffectData.EffectType == EEffectType::HealingOverTime)
+    }
+    
+    return INDEX_NONE;
+}
+
+void UEffectApplicationComponent::AddPersistentSlotCue(int32 Slot, int32 EffectID, AActor* InstigatorActor, UEffectDataAsset* DataAsset)
+{
+    UAbilitySystemComponent* OwnerASC = PersistentFeedbackASC.Get();
+    if (!OwnerASC)
+    {
+        return;
+    }
+    
+    // Same payload as the application cue; the added cue replicates until the slot is released
+    FGameplayCueParameters Parameters;
+    Parameters.Instigator = InstigatorActor;
+    Parameters.EffectCauser = InstigatorActor;
+    Parameters.SourceObject = DataAsset;
+    Parameters.RawMagnitude = static_cast<float>(EffectID);
+    
+    OwnerASC->AddGameplayCue(GetPersistentSlotTag(Slot), Parameters);
+}
+
+void UEffectApplicationComponent::ReleasePersistentSlot(int32 Slot)
+{
+    if (PersistentSlots[Slot].IsFree())
+    {
+        return;
+    }
+    
+    PersistentSlots[Slot] = FPersistentSlot();
+    
+    if (UAbilitySystemComponent* OwnerASC = PersistentFeedbackASC.Get())
+    {
+        OwnerASC->RemoveGameplayCue(GetPersistentSlotTag(Slot));
+    }
+}
+
+void UEffectApplicationComponent::ReleaseAllPersistentSlots()
+{
+    for (int32 Slot = 0; Slot < MaxPersistentFeedback; ++Slot)
+    {
+        ReleasePersistentSlot(Slot);
+    }
+}
+
+void UEffectApplicationComponent::OnPersistentEffectRemoved(const FGameplayEffectRemovalInfo& RemovalInfo)
+{
+    if (!RemovalInfo.ActiveEffect)
+    {
+        return;
+    }
+    
+    // A slot released early (death) may already belong to another effect, so match on the handle
+    for (int32 Slot = 0; Slot < MaxPersistentFeedback; ++Slot)
+    {
+        if (PersistentSlots[Slot].ActiveHandle == RemovalInfo.ActiveEffect->Handle)
         {
-            FGameplayTag HealingTag = FGameplayTag::RequestGameplayTag(FName("Data.Healing"));
-            SpecHandle.Data->SetSetByCallerMagnitude(HealingTag, CalculatedMagnitude);
+            ReleasePersistentSlot(Slot);
+            return;
         }
-        // Other effects use generic magnitude tag
-        else 
+    }
+}
+
+void UEffectApplicationComponent::OnPersistentPeriodicEffectEnded(FPeriodicEffectHandle PeriodicHandle)
+{
+    // Same as above: the handle tells the entry apart from whatever took over its slot
+    for (int32 Slot = 0; Slot < MaxPersistentFeedback; ++Slot)
+    {
+        if (PersistentSlots[Slot].PeriodicHandle == PeriodicHandle)
         {
-            FGameplayTag MagnitudeTag = FGameplayTag::RequestGameplayTag(FName("Data.Magnitude"));
-            SpecHandle.Data->SetSetByCallerMagnitude(MagnitudeTag, CalculatedMagnitude);
+            ReleasePersistentSlot(Slot);
+            return;
         }
     }
+}
+
+void UEffectApplicationComponent::OnOwnerDeadTagChanged(const FGameplayTag Tag, int32 NewCount)
+{
+    if (NewCount > 0)
+    {
+        ReleaseAllPersistentSlots();
+    }
+}
+
+void UEffectApplicationComponent::StartPersistentVisual(int32 Slot, const FGameplayCueParameters& Parameters)
+{
+    const int32 EffectID = FMath::RoundToInt(Parameters.RawMagnitude);
+    
+    // WhileActive can repeat for a cue that is already showing
+    FPersistentVisual& Visual = PersistentVisuals[Slot];
+    if (Visual.EffectID == EffectID)
+    {
+        return;
+    }
+    
+    StopPersistentVisual(Slot);
+    
+    UEffectFeedbackSubsystem* FeedbackPlayer = UEffectFeedbackSubsystem::Get(this);
+    FEffectDataSnapshotPtr EffectSnapshot;
+    const FEffectTableRow* EffectData = FindCueEffectRow(Parameters, EffectSnapshot);
+    if (!FeedbackPlayer || !EffectData || !GetOwner())
+    {
+        return;
+    }
+    
+    const AActor* InstigatorActor = Parameters.Instigator.Get();
+    Visual.EffectID = EffectID;
+    
+    if (UNiagaraSystem* VFX = EffectData->PersistentVFX.Get())
+    {
+        Visual.VFX = FeedbackPlayer->PlayAttached(VFX, GetOwner(), EffectID, InstigatorActor);
+    }
+    
+    if (USoundBase* Sound = EffectData->PersistentSound.Get())
+    {
+        // Attached like the VFX so a looping sound follows the target around
+        Visual.Sound = FeedbackPlayer->PlaySoundAttached(Sound, GetOwner(), InstigatorActor);
+        Visual.SoundAsset = Sound;
+    }
+}
+
+void UEffectApplicationComponent::StopPersistentVisual(int32 Slot)
+{
+    FPersistentVisual& Visual = PersistentVisuals[Slot];
+    if (Visual.EffectID == INDEX_NONE)
+    {
+        return;
+    }
+    
+    if (UEffectFeedbackSubsystem* FeedbackPlayer = UEffectFeedbackSubsystem::Get(this))
+    {
+        FeedbackPlayer->StopAttached(Visual.VFX.Get(), GetOwner());
+        FeedbackPlayer->StopSound(Visual.Sound.Get(), Visual.SoundAsset.Get());
+    }
+    
+    Visual = FPersistentVisual();
+}
+
+float UEffectApplicationComponent::GetStatValue(AActor* Actor, const FGameplayTag& StatTag) const
+{
+    if (!Actor || !StatTag.IsValid())
+    {
+        return 0.0f;
+    }
+    
+    // Map the tag to an attribute through the prebuilt table
+    const FGameplayAttribute StatAttribute = UWoWAttributeSet::GetAttributeForStatTag(StatTag);
+    if (!StatAttribute.IsValid())
+    {
+        return 0.0f;
+    }
+    
+    // Try to get the character
+    AWoWCharacterBase* Character = Cast<AWoWCharacterBase>(Actor);
+    if (!Character)
+    {
+        return 0.0f;
+    }
+    
+    // Get the attribute set
+    UWoWAttributeSet* AttributeSet = Character->GetAttributeSet();
+    if (!AttributeSet)
+    {
+        return 0.0f;
+    }
+    
+    return StatAttribute.GetNumericValue(AttributeSet);
+}
+
+float UEffectApplicationComponent::GetStatValue(AActor* Actor, const FGameplayAttribute& StatAttribute) const
+{
+    UAbilitySystemComponent* ASC = GetAbilitySystemComponent(Actor);
+    if (!ASC || !StatAttribute.IsValid())
+    {
+        return 0.0f;
+    }
+    
+    return ASC->GetNumericAttribute(StatAttribute);
+}
+
+FGameplayEffectSpecHandle UEffectApplicationComponent::CreateEffectSpec(const FCompiledEffectRecord& Effect, const UGameplayEffect* EffectCDO, AActor* SourceActor, float Level, float CalculatedMagnitude)
+{
+    if (!EffectCDO || !SourceActor)
+    {
+        return FGameplayEffectSpecHandle();
+    }
+    
+    // Use the source ASC's context when there is one, otherwise a bare context
+    UAbilitySystemComponent* SourceASC = GetAbilitySystemComponent(SourceActor);
+    FGameplayEffectContextHandle EffectContext = SourceASC 
+        ? SourceASC->MakeEffectContext() 
+        : FGameplayEffectContextHandle(UAbilitySystemGlobals::Get().AllocGameplayEffectContext());
+    EffectContext.AddSourceObject(SourceActor);
+    
+    // Damage goes in as a negative value, everything else as-is
+    const float SetByCallerValue = Effect.HasFlag(EEffectRecordFlags::NegateMagnitude) ? -CalculatedMagnitude : CalculatedMagnitude;
     
-    return SpecHandle;
+    // Clone the prebuilt template for this effect and level instead of initializing a fresh spec
+    return SpecCache.MakeSpec(Effect.EffectID, EffectCDO, Level, EffectContext, Effect.SetByCallerTag, SetByCallerValue);
 }
\ No newline at end of file
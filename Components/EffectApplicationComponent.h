@@ -3,16 +3,22 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Containers/StaticArray.h"
 #include "../Data/AbilityEffectTypes.h"
 #include "GameplayEffectTypes.h"
+#include "../Abilities/Effects/EffectSpecCache.h"
+#include "../Abilities/Effects/PeriodicEffectSubsystem.h"
 #include "EffectApplicationComponent.generated.h"
 
 class UEffectDataAsset;
 class UAbilitySystemComponent;
 class UNiagaraSystem;
+class UNiagaraComponent;
 class USoundBase;
+class UAudioComponent;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnEffectApplied, int32, EffectID, AActor*, Target, bool, WasSuccessful);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAreaEffectApplied, int32, EffectID, const TArray<AActor*>&, Targets);
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class MYPROJECT5_API UEffectApplicationComponent : public UActorComponent
@@ -24,6 +30,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:    
     // Main function to apply a single effect to a target
@@ -38,7 +45,8 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Effects")
     bool ApplyEffectContainerToTarget(const FEffectContainerSpec& EffectContainer, AActor* TargetActor, float Level = 1.0f);
     
-    // Apply area effects around a target
+    // Apply area effects around a target. Each effect is resolved and specced once and applied to every
+    // target in one pass; returns the number of targets that received or have queued at least one effect
     UFUNCTION(BlueprintCallable, Category = "Effects")
     int32 ApplyAreaEffects(const TArray<int32>& EffectIDs, AActor* CenterActor, float Radius, float Level = 1.0f);
     
@@ -46,32 +54,144 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Effects")
     float CalculateEffectMagnitude(const FEffectTableRow& EffectData, AActor* SourceActor, AActor* TargetActor, float Level = 1.0f);
     
+    // Calculate one of the record's secondary magnitudes by its FEffectMagnitudeNames index (0 if the effect does not have it)
+    float CalculateAdditionalMagnitude(const FCompiledEffectRecord& Effect, int32 MagnitudeIndex, AActor* SourceActor, AActor* TargetActor, float Level) const;
+    
     // Set the effect data asset
     UFUNCTION(BlueprintCallable, Category = "Effects")
-    void SetEffectDataAsset(UEffectDataAsset* NewDataAsset) { CachedEffectDataAsset = NewDataAsset; }
+    void SetEffectDataAsset(UEffectDataAsset* NewDataAsset);
     
     // Get the effect data asset
     UFUNCTION(BlueprintPure, Category = "Effects")
     UEffectDataAsset* GetEffectDataAsset() const { return CachedEffectDataAsset; }
     
-    // Event when an effect is applied
+    // Event when an effect is applied. Instant effects deferred to the combat queue fire it after the flush applied them
     UPROPERTY(BlueprintAssignable, Category = "Effects")
     FOnEffectApplied OnEffectApplied;
+    
+    // Event when an area effect lands, once per effect with every target it was applied to.
+    // Fires after the combat queue flush when any of the targets were queued
+    UPROPERTY(BlueprintAssignable, Category = "Effects")
+    FOnAreaEffectApplied OnAreaEffectApplied;
+    
+    // Play the feedback of a GameplayCue.Effect.* cue on this component's owner. Returns false for any other cue
+    bool HandleFeedbackCue(const FGameplayTag& CueTag, EGameplayCueEvent::Type EventType, const FGameplayCueParameters& Parameters);
+    
+    // Server: show the persistent feedback of an active duration effect on this component's owner until the effect
+    // is removed, the owner dies or the ASC goes away. Returns false if every persistent slot is taken
+    bool AddPersistentFeedback(UAbilitySystemComponent* OwnerASC, FActiveGameplayEffectHandle ActiveHandle, int32 EffectID, AActor* InstigatorActor, UEffectDataAsset* DataAsset);
+    
+    // Same for a DoT/HoT running in the periodic scheduler; the slot is released when the scheduler entry ends
+    bool AddPersistentFeedback(UAbilitySystemComponent* OwnerASC, FPeriodicEffectHandle PeriodicHandle, int32 EffectID, AActor* InstigatorActor, UEffectDataAsset* DataAsset);
+    
+    // Most persistent effect visuals one target shows at once, one cue slot each
+    static constexpr int32 MaxPersistentFeedback = 8;
 
 protected:
+    // Most targets of one area effect that get their own feedback cue and persistent feedback. Only the first one carries the sound
+    UPROPERTY(EditDefaultsOnly, Category = "Effects")
+    int32 MaxAreaFeedbackTargets;
+    
     // Reference to the effect data asset
     UPROPERTY()
     UEffectDataAsset* CachedEffectDataAsset;
     
+    // Spec templates for effects applied by this component's owner
+    FEffectSpecCache SpecCache;
+    
     // Helper to get the ASC from an actor
     UAbilitySystemComponent* GetAbilitySystemComponent(AActor* Actor) const;
     
-    // Helper to play effect VFX and audio
-    void PlayEffectFeedback(const FEffectTableRow& EffectData, AActor* TargetActor, bool IsPersistent);
+    // Helper to play an effect's application VFX and audio
+    void PlayEffectFeedback(const FEffectTableRow& EffectData, AActor* TargetActor, const AActor* InstigatorActor, bool bPlaySound = true);
+    
+    // Send an effect feedback cue for TargetASC, predicted locally when the owner is inside a prediction window
+    void SendFeedbackCue(UAbilitySystemComponent* TargetASC, const FGameplayTag& CueTag, int32 EffectID);
+    
+    // Fire OnAreaEffectApplied for the targets that are still around, if any
+    void BroadcastAreaEffect(int32 EffectID, const TArray<TWeakObjectPtr<AActor>>& AppliedTargets);
+    
+    // ApplyEffectToTarget; returns true if the effect was applied, scheduled or queued
+    bool ApplyEffectToTargetInternal(int32 EffectID, AActor* TargetActor, float Level, FActiveGameplayEffectHandle& OutHandle);
+    
+    // Hand a table-driven DoT/HoT tick spec to the periodic scheduler. Invalid handle if the effect is not one,
+    // in which case the spec is applied as usual
+    FPeriodicEffectHandle SchedulePeriodicEffect(const FCompiledEffectRecord& Effect, UAbilitySystemComponent* TargetASC, const FGameplayEffectSpec& TickSpec) const;
+    
+    // Hand a duration effect that just landed on TargetActor to that target's persistent feedback slots
+    void AddPersistentFeedbackToTarget(AActor* TargetActor, UAbilitySystemComponent* TargetASC, FActiveGameplayEffectHandle ActiveHandle, int32 EffectID);
+    void AddPersistentFeedbackToTarget(AActor* TargetActor, UAbilitySystemComponent* TargetASC, FPeriodicEffectHandle PeriodicHandle, int32 EffectID);
+    
+    // Server side of the persistent feedback: a free slot on OwnerASC, INDEX_NONE if the owner is dead or every slot is taken
+    int32 FindFreePersistentSlot(UAbilitySystemComponent* OwnerASC);
+    
+    // Server side of the persistent feedback: add the cue of a slot that was just taken
+    void AddPersistentSlotCue(int32 Slot, int32 EffectID, AActor* InstigatorActor, UEffectDataAsset* DataAsset);
+    
+    // Server side of the persistent feedback: free a slot and remove its cue
+    void ReleasePersistentSlot(int32 Slot);
+    
+    // Server side of the persistent feedback: free every slot
+    void ReleaseAllPersistentSlots();
+    
+    void OnPersistentEffectRemoved(const FGameplayEffectRemovalInfo& RemovalInfo);
+    
+    void OnPersistentPeriodicEffectEnded(FPeriodicEffectHandle PeriodicHandle);
+    
+    void OnOwnerDeadTagChanged(const FGameplayTag Tag, int32 NewCount);
+    
+    // Client side of the persistent feedback
+    void StartPersistentVisual(int32 Slot, const FGameplayCueParameters& Parameters);
+    void StopPersistentVisual(int32 Slot);
+    
+    // Cue slot of a GameplayCue.Effect.Persistent.SlotN tag, INDEX_NONE for any other tag
+    static int32 GetPersistentSlot(const FGameplayTag& CueTag);
+    
+    // What one persistent slot is playing on this client
+    struct FPersistentVisual
+    {
+        int32 EffectID = INDEX_NONE;
+        TWeakObjectPtr<UNiagaraComponent> VFX;
+        TWeakObjectPtr<UAudioComponent> Sound;
+        TWeakObjectPtr<const USoundBase> SoundAsset;
+    };
+    
+    // Server: what one persistent slot belongs to, either an active effect or a periodic scheduler entry
+    struct FPersistentSlot
+    {
+        FActiveGameplayEffectHandle ActiveHandle;
+        FPeriodicEffectHandle PeriodicHandle;
+        
+        bool IsFree() const { return !ActiveHandle.IsValid() && !PeriodicHandle.IsValid(); }
+    };
+    
+    // Server: the effect each persistent slot belongs to
+    TStaticArray<FPersistentSlot, MaxPersistentFeedback> PersistentSlots;
+    
+    // Client: the visuals each persistent slot is playing
+    TStaticArray<FPersistentVisual, MaxPersistentFeedback> PersistentVisuals;
+    
+    // The owner ASC the persistent slots' cues and death listener live on
+    TWeakObjectPtr<UAbilitySystemComponent> PersistentFeedbackASC;
+    
+    FDelegateHandle DeadTagEventHandle;
     
     // Helper to get stats from a character
     float GetStatValue(AActor* Actor, const FGameplayTag& StatTag) const;
     
-    // Helper to make the gameplay effect spec
-    FGameplayEffectSpecHandle CreateEffectSpec(const FEffectTableRow& EffectData, AActor* SourceActor, AActor* TargetActor, float Level, float CalculatedMagnitude);
+    // Read a pre-resolved attribute straight from the actor's ASC
+    float GetStatValue(AActor* Actor, const FGameplayAttribute& StatAttribute) const;
+    
+    // Calculate the final magnitude from a compiled record
+    float CalculateRecordMagnitude(const FCompiledEffectRecord& Effect, AActor* SourceActor, AActor* TargetActor, float Level) const;
+    
+    // Evaluate one compiled magnitude
+    float EvaluateMagnitude(const FCompiledEffectMagnitude& Magnitude, AActor* SourceActor, AActor* TargetActor, float Level) const;
+    
+    // Calculate the magnitude of one record for many targets, reading source stats once
+    void CalculateRecordMagnitudes(const FCompiledEffectRecord& Effect, AActor* SourceActor, TArrayView<AActor* const> TargetActors, float Level, TArray<float>& OutMagnitudes) const;
+    
+    // Helper to make the gameplay effect spec. EffectCDO is the record's resolved GE, which a snapshot held
+    // from before the class loaded does not have yet
+    FGameplayEffectSpecHandle CreateEffectSpec(const FCompiledEffectRecord& Effect, const UGameplayEffect* EffectCDO, AActor* SourceActor, float Level, float CalculatedMagnitude);
 };
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "../Character/WoWPlayerCharacter.h"
 #include "../States/WoWPlayerState.h"
 #include "GameplayAbilitySpec.h"
+#include "../WoWGameplayTags.h"
+#include "CombatStateComponent.h"
 
 UHotbarComponent::UHotbarComponent()
 {
@@ -43,31 +45,11 @@ void UHotbarComponent::OnRep_HotbarSlots()
     // This is important because pointers don't replicate
     if (AbilityDataAsset)
     {
-        for (int32 i = 0; i < HotbarSlots.Num(); ++i)
-        {
-            // Clear any existing pointer first
-            HotbarSlots[i].AbilityData = nullptr;
-            
-            if (HotbarSlots[i].AbilityID > 0)
-            {
-                // Use a temporary stack variable so we don't dereference a bad pointer
-                static TArray<FAbilityTableRow*> AllRows;
-                if (AllRows.Num() == 0 && AbilityDataAsset->AbilityDataTable)
-                {
-                    AbilityDataAsset->AbilityDataTable->GetAllRows<FAbilityTableRow>(TEXT("OnRep_HotbarSlots"), AllRows);
-                }
-                
-                // Find the row with the matching ID
-                for (FAbilityTableRow* Row : AllRows)
-                {
-                    if (Row && Row->AbilityID == HotbarSlots[i].AbilityID)
-                    {
-                        HotbarSlots[i].AbilityData = Row;
-                        break;
-                    }
-                }
-            }
-        }
+        // Make sure the icons for the replicated slots are streaming
+        AbilityDataAsset->RequestAsyncPreload();
+        
+        BindToAbilityData(AbilityDataAsset);
+        OnAbilityDataSnapshotChanged(AbilityDataAsset->GetSnapshot());
     }
     
     if (GEngine)
@@ -163,6 +145,13 @@ void UHotbarComponent::InitializeHotbar(UAbilityDataAsset* DataAsset)
     }
     
     AbilityDataAsset = DataAsset;
+    BindToAbilityData(AbilityDataAsset);
+    
+    // Hotbar icons are only needed where there is a screen
+    if (GetNetMode() != NM_DedicatedServer)
+    {
+        AbilityDataAsset->RequestAsyncPreload();
+    }
     
     // On clients, we just store the data asset
     // The server will handle ability granting
@@ -187,43 +176,75 @@ void UHotbarComponent::InitializeHotbar(UAbilityDataAsset* DataAsset)
     }
     
     // Go through all abilities and set them in their default slots
-    TArray<FAbilityTableRow*> AllAbilities;
-    DataAsset->AbilityDataTable->GetAllRows(TEXT("InitializeHotbar"), AllAbilities);
+    FAbilityDataSnapshotPtr Snapshot = DataAsset->GetSnapshot();
+    if (!Snapshot.IsValid())
+    {
+        return;
+    }
     
-    for (FAbilityTableRow* AbilityRow : AllAbilities)
+    for (const FAbilityRowPtr& AbilityRow : Snapshot->Rows)
     {
-        if (AbilityRow && AbilityRow->DefaultHotbarSlot > 0 && AbilityRow->DefaultHotbarSlot <= HotbarSlots.Num())
+        if (AbilityRow->DefaultHotbarSlot > 0 && AbilityRow->DefaultHotbarSlot <= HotbarSlots.Num())
         {
             SetAbilityInSlot(AbilityRow->DefaultHotbarSlot - 1, AbilityRow->AbilityID);
         }
     }
 }
 
-void UHotbarComponent::SetAbilityInSlot(int32 SlotIndex, int32 AbilityID)
+void UHotbarComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    if (SlotIndex < 0 || SlotIndex >= HotbarSlots.Num() || !AbilityDataAsset || !AbilityDataAsset->AbilityDataTable)
+    UnbindFromAbilityData();
+    
+    Super::EndPlay(EndPlayReason);
+}
+
+void UHotbarComponent::BindToAbilityData(UAbilityDataAsset* DataAsset)
+{
+    if (BoundAbilityDataAsset.Get() == DataAsset)
     {
         return;
     }
     
-    // Get ability data from data table
-    static const FString ContextString(TEXT("SetAbilityInSlot"));
-    FAbilityTableRow* AbilityData = nullptr;
+    UnbindFromAbilityData();
     
-    // Find ability data in table
-    TArray<FAbilityTableRow*> AllRows;
-    AbilityDataAsset->AbilityDataTable->GetAllRows(ContextString, AllRows);
+    if (DataAsset)
+    {
+        AbilityDataChangedHandle = DataAsset->OnSnapshotChanged.AddUObject(this, &UHotbarComponent::OnAbilityDataSnapshotChanged);
+        BoundAbilityDataAsset = DataAsset;
+    }
+}
+
+void UHotbarComponent::UnbindFromAbilityData()
+{
+    if (UAbilityDataAsset* OldAsset = BoundAbilityDataAsset.Get())
+    {
+        OldAsset->OnSnapshotChanged.Remove(AbilityDataChangedHandle);
+    }
     
-    for (FAbilityTableRow* Row : AllRows)
+    AbilityDataChangedHandle.Reset();
+    BoundAbilityDataAsset.Reset();
+}
+
+void UHotbarComponent::OnAbilityDataSnapshotChanged(const FAbilityDataSnapshotPtr& NewSnapshot)
+{
+    for (FHotbarSlot& Slot : HotbarSlots)
     {
-        if (Row && Row->AbilityID == AbilityID)
-        {
-            AbilityData = Row;
-            break;
-        }
+        // A row removed by the reload leaves the slot empty rather than dangling
+        Slot.AbilityData = (NewSnapshot.IsValid() && Slot.AbilityID > 0) ? NewSnapshot->FindSharedByID(Slot.AbilityID) : FAbilityRowPtr();
+    }
+}
+
+void UHotbarComponent::SetAbilityInSlot(int32 SlotIndex, int32 AbilityID)
+{
+    if (SlotIndex < 0 || SlotIndex >= HotbarSlots.Num() || !AbilityDataAsset || !AbilityDataAsset->AbilityDataTable)
+    {
+        return;
     }
     
-    if (!AbilityData)
+    // Find ability data in table
+    FAbilityRowPtr AbilityData = AbilityDataAsset->FindSharedAbilityDataByID(AbilityID);
+    
+    if (!AbilityData.IsValid())
     {
         return;
     }
@@ -233,7 +254,7 @@ void UHotbarComponent::SetAbilityInSlot(int32 SlotIndex, int32 AbilityID)
     HotbarSlots[SlotIndex].AbilityData = AbilityData;
     
     // Grant the ability to the owner
-    GrantAbilityToOwner(SlotIndex, AbilityData);
+    GrantAbilityToOwner(SlotIndex, AbilityData.Get());
 }
 
 void UHotbarComponent::GrantAbilityToOwner(int32 SlotIndex, const FAbilityTableRow* AbilityData)
@@ -340,7 +361,7 @@ void UHotbarComponent::ActivateAbilityInSlot(int32 SlotIndex)
     }
     
     const FHotbarSlot& Slot = HotbarSlots[SlotIndex];
-    if (!Slot.AbilityData)
+    if (!Slot.AbilityData.IsValid())
     {
         if (GEngine)
         {
@@ -390,6 +411,11 @@ void UHotbarComponent::ActivateAbilityInSlot(int32 SlotIndex)
     if (bSuccess && Slot.AbilityData->bUsesGlobalCooldown)
     {
         GlobalCooldownStartTime = GetWorld()->GetTimeSeconds();
+        
+        if (UCombatStateComponent* CombatState = UCombatStateComponent::FindForActor(GetOwner()))
+        {
+            CombatState->StartGlobalCooldown(GlobalCooldownDuration);
+        }
     }
 }
 
@@ -400,6 +426,11 @@ void UHotbarComponent::ServerActivateAbilityInSlot_Implementation(int32 SlotInde
 
 bool UHotbarComponent::IsOnGlobalCooldown() const
 {
+    if (const UCombatStateComponent* CombatState = UCombatStateComponent::FindForActor(GetOwner()))
+    {
+        return CombatState->HasAnyState(ECombatStateFlags::GlobalCooldown);
+    }
+    
     return (GetWorld()->GetTimeSeconds() - GlobalCooldownStartTime) < GlobalCooldownDuration;
 }
 
@@ -410,7 +441,7 @@ bool UHotbarComponent::GetAbilityDataForSlot(int32 SlotIndex, FAbilityTableRow&
         return false;
     }
     
-    if (HotbarSlots[SlotIndex].AbilityData)
+    if (HotbarSlots[SlotIndex].AbilityData.IsValid())
     {
         OutAbilityData = *HotbarSlots[SlotIndex].AbilityData;
         return true;
@@ -566,12 +597,15 @@ float UHotbarComponent::GetAbilityCooldownRemainingTime(int32 SlotIndex) const
         return 0.0f;
     }
 
-    // Get ability data
-    FAbilityTableRow AbilityData;
-    if (!GetAbilityDataForSlot(SlotIndex, AbilityData))
+    // Get ability data (the slot's shared row, no copy)
+    const FAbilityTableRow* AbilityData = HotbarSlots[SlotIndex].AbilityData.Get();
+    if (!AbilityData)
     {
         return 0.0f;
     }
+    
+    // Registered when the ability table loaded
+    const FGameplayTag IDCooldownTag = FAbilityCooldownTags::Find(AbilityData->AbilityID);
 
     // Check for GE-based cooldowns - only return values we can reliably determine
     TArray<FActiveGameplayEffectHandle> ActiveEffects = ASC->GetActiveEffects(FGameplayEffectQuery());
@@ -589,31 +623,15 @@ float UHotbarComponent::GetAbilityCooldownRemainingTime(int32 SlotIndex) const
         bool isForOurAbility = false;
         
         // If we have a cooldown tag defined, check for that specific tag
-        if (AbilityData.CooldownTag.IsValid())
+        if (AbilityData->CooldownTag.IsValid())
         {
-            for (const FGameplayTag& Tag : Effect->Spec.DynamicGrantedTags)
-            {
-                if (Tag == AbilityData.CooldownTag)
-                {
-                    isForOurAbility = true;
-                    break;
-                }
-            }
+            isForOurAbility = Effect->Spec.DynamicGrantedTags.HasTagExact(AbilityData->CooldownTag);
         }
         
-        // Check for ID-based cooldown tags
-        if (!isForOurAbility)
+        // Check for the ID-based cooldown tag
+        if (!isForOurAbility && IDCooldownTag.IsValid())
         {
-            for (const FGameplayTag& Tag : Effect->Spec.DynamicGrantedTags)
-            {
-                FString TagStr = Tag.ToString();
-                if (TagStr.Contains("Cooldown") && 
-                    TagStr.Contains(FString::Printf(TEXT("ID.%d"), AbilityData.AbilityID)))
-                {
-                    isForOurAbility = true;
-                    break;
-                }
-            }
+            isForOurAbility = Effect->Spec.DynamicGrantedTags.HasTagExact(IDCooldownTag);
         }
         
         // If this is a cooldown for our ability, return its remaining time
@@ -770,9 +788,9 @@ bool UHotbarComponent::IsAbilityOnCooldownByGameplayEffect(int32 SlotIndex) cons
         return false;
     }
 
-    // Get ability data for the slot
-    FAbilityTableRow AbilityData;
-    if (!GetAbilityDataForSlot(SlotIndex, AbilityData))
+    // Get ability data for the slot (the slot's shared row, no copy)
+    const FAbilityTableRow* AbilityData = HotbarSlots[SlotIndex].AbilityData.Get();
+    if (!AbilityData)
     {
         return false;
     }
@@ -781,17 +799,16 @@ bool UHotbarComponent::IsAbilityOnCooldownByGameplayEffect(int32 SlotIndex) cons
     // This should match how tags are added in WoWGameplayAbilityBase::EndAbility
     
     // First check for the ability-specific cooldown tag from the ability data
-    if (AbilityData.CooldownTag.IsValid())
+    if (AbilityData->CooldownTag.IsValid())
     {
-        if (ASC->HasMatchingGameplayTag(AbilityData.CooldownTag))
+        if (ASC->HasMatchingGameplayTag(AbilityData->CooldownTag))
         {
             return true;
         }
     }
     
-    // Check for ID-based cooldown tag (fallback if no specific tag in ability data)
-    FGameplayTag IDCooldownTag = FGameplayTag::RequestGameplayTag(
-        FName(*FString::Printf(TEXT("Ability.Cooldown.ID.%d"), AbilityData.AbilityID)), false);
+    // Check for ID-based cooldown tag (fallback if no specific tag in ability data), registered when the table loaded
+    const FGameplayTag IDCooldownTag = FAbilityCooldownTags::Find(AbilityData->AbilityID);
     
     if (IDCooldownTag.IsValid() && ASC->HasMatchingGameplayTag(IDCooldownTag))
     {
@@ -800,9 +817,9 @@ bool UHotbarComponent::IsAbilityOnCooldownByGameplayEffect(int32 SlotIndex) cons
     
     // Check for spell name-based cooldown tag (another possible format)
     FString SpellTagStr = "Ability.Cooldown.Spell.";
-    if (!AbilityData.DisplayName.IsEmpty())
+    if (!AbilityData->DisplayName.IsEmpty())
     {
-        FString SpellName = AbilityData.DisplayName;
+        FString SpellName = AbilityData->DisplayName;
         // Convert spaces to underscores for tag format
         SpellName.ReplaceInline(TEXT(" "), TEXT("_"));
         FGameplayTag SpellCooldownTag = FGameplayTag::RequestGameplayTag(
@@ -829,7 +846,7 @@ bool UHotbarComponent::IsAbilityOnCooldownByGameplayEffect(int32 SlotIndex) cons
         for (const FGameplayTag& Tag : Effect->Spec.DynamicGrantedTags)
         {
             // If this effect grants our specific cooldown tag
-            if ((AbilityData.CooldownTag.IsValid() && Tag == AbilityData.CooldownTag) ||
+            if ((AbilityData->CooldownTag.IsValid() && Tag == AbilityData->CooldownTag) ||
                 (IDCooldownTag.IsValid() && Tag == IDCooldownTag))
             {
                 hasCooldownForThisAbility = true;
@@ -872,31 +889,30 @@ bool UHotbarComponent::IsAbilityOnCooldownByTag(int32 SlotIndex) const
         return false;
     }
 
-    // Get the ability data to find its cooldown tag
-    FAbilityTableRow AbilityData;
-    if (!GetAbilityDataForSlot(SlotIndex, AbilityData))
+    // Get the ability data to find its cooldown tag (the slot's shared row, no copy)
+    const FAbilityTableRow* AbilityData = HotbarSlots[SlotIndex].AbilityData.Get();
+    if (!AbilityData)
     {
         return false;
     }
 
     // Check for ability-specific cooldown tag
-    if (AbilityData.CooldownTag.IsValid())
+    if (AbilityData->CooldownTag.IsValid())
     {
-        if (ASC->HasMatchingGameplayTag(AbilityData.CooldownTag))
+        if (ASC->HasMatchingGameplayTag(AbilityData->CooldownTag))
         {
             return true;
         }
     }
 
-    // Check for generic cooldown tag format
-    FName TagName = FName(*FString::Printf(TEXT("Ability.Cooldown.ID.%d"), AbilityData.AbilityID));
-    FGameplayTag GenericCooldownTag = FGameplayTag::RequestGameplayTag(TagName, false);
+    // Check for the per-ability ID tag registered when the table loaded
+    const FGameplayTag GenericCooldownTag = FAbilityCooldownTags::Find(AbilityData->AbilityID);
     if (GenericCooldownTag.IsValid() && ASC->HasMatchingGameplayTag(GenericCooldownTag))
     {
         return true;
     }
 
     // Fallback to base cooldown tag
-    FGameplayTag BaseCooldownTag = FGameplayTag::RequestGameplayTag(FName("Ability.Cooldown"), false);
+    FGameplayTag BaseCooldownTag = WoWGameplayTags::Ability_Cooldown;
     return ASC->HasMatchingGameplayTag(BaseCooldownTag);
 }
\ No newline at end of file
@@ -3,11 +3,10 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "GameplayAbilitySpec.h"
+#include "../Data/AbilityDataAsset.h"
 #include "HotbarComponent.generated.h"
 
-class UAbilityDataAsset;
 class UAbilitySystemComponent;
-struct FAbilityTableRow;
 
 USTRUCT(BlueprintType)
 struct FHotbarSlot
@@ -28,12 +27,11 @@ struct FHotbarSlot
     UPROPERTY()
     FGameplayAbilitySpecHandle AbilityHandle;
     
-    // Cached ability data - Not exposed to Blueprint
-    const FAbilityTableRow* AbilityData;
+    // Shared ability row - Not exposed to Blueprint. Stays valid across data reloads, rebound on every snapshot swap
+    FAbilityRowPtr AbilityData;
     
     FHotbarSlot()
         : AbilityID(-1)
-        , AbilityData(nullptr)
     {
     }
 };
@@ -51,6 +49,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:    
 
@@ -150,4 +149,16 @@ protected:
     
     // Grant ability to owner's ability system
     void GrantAbilityToOwner(int32 SlotIndex, const FAbilityTableRow* AbilityData);
+    
+    // Listen for snapshot swaps on the data asset so slots pick up rebalanced rows
+    void BindToAbilityData(UAbilityDataAsset* DataAsset);
+    void UnbindFromAbilityData();
+    
+    // Point every slot at its row in the given snapshot
+    void OnAbilityDataSnapshotChanged(const FAbilityDataSnapshotPtr& NewSnapshot);
+    
+    // The asset we are listening to
+    TWeakObjectPtr<UAbilityDataAsset> BoundAbilityDataAsset;
+    
+    FDelegateHandle AbilityDataChangedHandle;
 };
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include "AbilitySystemInterface.h"
 #include "GameFramework/PlayerState.h"
 #include "../Abilities/WoWAutoAttackAbility.h"
+#include "CombatStateComponent.h"
+#include "../WoWGameplayTags.h"
 
 UTargetingComponent::UTargetingComponent()
 {
@@ -27,6 +29,19 @@ UTargetingComponent::UTargetingComponent()
 void UTargetingComponent::BeginPlay()
 {
     Super::BeginPlay();
+    
+    // The tag name is configurable, so resolve it here instead of on every attack
+    const FGameplayTag AbilityTag = FGameplayTag::RequestGameplayTag(AutoAttackAbilityTag, false);
+    
+    AutoAttackAbilityTags.Reset();
+    if (AbilityTag.IsValid())
+    {
+        AutoAttackAbilityTags.AddTag(AbilityTag);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s: unknown auto-attack ability tag %s"), *GetName(), *AutoAttackAbilityTag.ToString());
+    }
 }
 
 void UTargetingComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -186,9 +201,16 @@ void UTargetingComponent::HandleAutoAttack()
         return;
     }
     
-    // Check if auto-attack ability is already active via tag
-    FGameplayTag AutoAttackTag = FGameplayTag::RequestGameplayTag(FName("Ability.AutoAttack.Active"));
-    if (AbilitySystemComponent->HasMatchingGameplayTag(AutoAttackTag))
+    // Auto-attack already running, or the owner can't swing at all: one mask test
+    const UCombatStateComponent* CombatState = UCombatStateComponent::FindForActor(Owner);
+    if (CombatState)
+    {
+        if (CombatState->HasAnyState(ECombatStateFlags::AutoAttacking | CombatStateIncapacitated))
+        {
+            return;
+        }
+    }
+    else if (AbilitySystemComponent->HasMatchingGameplayTag(WoWGameplayTags::Ability_AutoAttack_Active))
     {
         // Auto-attack already running, don't activate again
         return;
@@ -209,11 +231,8 @@ void UTargetingComponent::HandleAutoAttack()
     bIsAttackInProgress = true;
     
     // Activate the auto attack ability
-    FGameplayTagContainer AbilityTagContainer;
-    AbilityTagContainer.AddTag(FGameplayTag::RequestGameplayTag(FName(AutoAttackAbilityTag)));
-    
     // Activate the ability - this happens only once per auto-attack cycle
-    AbilitySystemComponent->TryActivateAbilitiesByTag(AbilityTagContainer);
+    AbilitySystemComponent->TryActivateAbilitiesByTag(AutoAttackAbilityTags);
 }
 
 void UTargetingComponent::ClearAttackInProgressFlag()
@@ -3,6 +3,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "GameplayTagContainer.h"
 #include "TargetingComponent.generated.h"
 
 class AWoWCharacterBase;
@@ -130,4 +131,7 @@ protected:
     // Auto-attack ability tag
     UPROPERTY(EditDefaultsOnly, Category = "Combat")
     FName AutoAttackAbilityTag;
+    
+    // AutoAttackAbilityTag resolved once in BeginPlay
+    FGameplayTagContainer AutoAttackAbilityTags;
 };
\ No newline at end of file
@@ -1,45 +1,604 @@
 #include "AbilityDataAsset.h"
+#include "CombatDatabase.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "UObject/PropertyPortFlags.h"
+#include "UObject/ObjectSaveContext.h"
+#include <atomic>
 
-bool UAbilityDataAsset::GetAbilityDataByID(int32 AbilityID, FAbilityTableRow& OutAbilityData) const
+namespace
 {
-    if (!AbilityDataTable)
+    // Bundle holding presentation-only assets
+    const FName ClientBundleName(TEXT("Client"));
+    
+    // Backing store for FAbilityCooldownTags. Each publish swaps in a complete new table, so readers on any
+    // thread only load one pointer. Replaced tables are kept (they are small and tables reload rarely) so a
+    // reader still holding one never sees it freed
+    struct FCooldownTagTable
     {
-        return false;
+        std::atomic<const TArray<FGameplayTag>*> Published{ nullptr };
+        
+        // Every table ever published, game thread only
+        TArray<TUniquePtr<const TArray<FGameplayTag>>> Tables;
+    };
+    
+    FCooldownTagTable& GetCooldownTagTable()
+    {
+        static FCooldownTagTable Table;
+        return Table;
+    }
+}
+
+FGameplayTag FAbilityCooldownTags::Resolve(int32 AbilityID)
+{
+    if (AbilityID < 0 || AbilityID > MaxAbilityID)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Ability ID %d is outside 0..%d, no per-ability cooldown tag registered"), 
+            AbilityID, MaxAbilityID);
+        return FGameplayTag();
     }
     
-    TArray<FAbilityTableRow*> AllAbilities;
-    AbilityDataTable->GetAllRows(TEXT("GetAbilityDataByID"), AllAbilities);
+    // The only place the tag name is ever built
+    const FName TagName(*FString::Printf(TEXT("Ability.Cooldown.ID.%d"), AbilityID));
+    const FGameplayTag CooldownTag = FGameplayTag::RequestGameplayTag(TagName, false);
+    
+    if (!CooldownTag.IsValid())
+    {
+        UE_LOG(LogTemp, Log, TEXT("Cooldown tag %s is not defined in the project tags, ability %d falls back to its row tag"), 
+            *TagName.ToString(), AbilityID);
+    }
+    
+    return CooldownTag;
+}
+
+void FAbilityCooldownTags::Publish(const FAbilityDataSnapshot& Snapshot)
+{
+    check(IsInGameThread());
+    
+    FCooldownTagTable& Table = GetCooldownTagTable();
     
-    for (FAbilityTableRow* AbilityRow : AllAbilities)
+    // Start from the published table so IDs from other ability assets stay registered
+    const TArray<FGameplayTag>* Current = Table.Published.load(std::memory_order_relaxed);
+    TUniquePtr<TArray<FGameplayTag>> NewTags = MakeUnique<TArray<FGameplayTag>>(Current ? *Current : TArray<FGameplayTag>());
+    
+    for (const FAbilityDefinitionPtr& Definition : Snapshot.Definitions)
     {
-        if (AbilityRow && AbilityRow->AbilityID == AbilityID)
+        const int32 AbilityID = Definition->AbilityID;
+        if (AbilityID < 0 || AbilityID > MaxAbilityID)
+        {
+            continue;
+        }
+        
+        if (NewTags->Num() <= AbilityID)
         {
-            OutAbilityData = *AbilityRow;
-            return true;
+            NewTags->SetNum(AbilityID + 1);
         }
+        
+        (*NewTags)[AbilityID] = Definition->IDCooldownTag;
     }
     
-    return false;
+    const TArray<FGameplayTag>* Published = NewTags.Get();
+    Table.Tables.Add(MoveTemp(NewTags));
+    Table.Published.store(Published, std::memory_order_release);
 }
 
-bool UAbilityDataAsset::GetAbilityDataBySlot(int32 SlotIndex, FAbilityTableRow& OutAbilityData) const
+FGameplayTag FAbilityCooldownTags::Find(int32 AbilityID)
 {
+    const TArray<FGameplayTag>* Tags = GetCooldownTagTable().Published.load(std::memory_order_acquire);
+    return Tags && Tags->IsValidIndex(AbilityID) ? (*Tags)[AbilityID] : FGameplayTag();
+}
+
+const FAbilityTableRow* FAbilityDataSnapshot::FindByID(int32 AbilityID) const
+{
+    const int32* RowIndex = IDIndex.Find(AbilityID);
+    return RowIndex ? Rows[*RowIndex].Get() : nullptr;
+}
+
+FAbilityRowPtr FAbilityDataSnapshot::FindSharedByID(int32 AbilityID) const
+{
+    const int32* RowIndex = IDIndex.Find(AbilityID);
+    return RowIndex ? Rows[*RowIndex] : FAbilityRowPtr();
+}
+
+FAbilityDefinitionPtr FAbilityDataSnapshot::FindDefinitionByID(int32 AbilityID) const
+{
+    const int32* RowIndex = IDIndex.Find(AbilityID);
+    return RowIndex ? Definitions[*RowIndex] : FAbilityDefinitionPtr();
+}
+
+const FAbilityTableRow* FAbilityDataSnapshot::FindBySlot(int32 InSlotIndex) const
+{
+    const int32* RowIndex = SlotIndex.Find(InSlotIndex);
+    return RowIndex ? Rows[*RowIndex].Get() : nullptr;
+}
+
+void FAbilityDataSnapshot::RebuildSlotIndex()
+{
+    SlotIndex.Reset();
+    
+    for (int32 RowIndex = 0; RowIndex < Rows.Num(); ++RowIndex)
+    {
+        // First row in table order wins
+        if (!SlotIndex.Contains(Rows[RowIndex]->DefaultHotbarSlot))
+        {
+            SlotIndex.Add(Rows[RowIndex]->DefaultHotbarSlot, RowIndex);
+        }
+    }
+}
+
+const FEffectContainerSpec& FAbilityRuntimeDefinition::GetEffectContainer(EEffectContainerType ContainerType) const
+{
+    static const FEffectContainerSpec EmptyContainer;
+    
+    const FEffectContainerSpec* Container = nullptr;
+    switch (ContainerType)
+    {
+        case EEffectContainerType::Self:
+            Container = SelfEffects;
+            break;
+            
+        case EEffectContainerType::Target:
+            Container = TargetEffects;
+            break;
+            
+        case EEffectContainerType::Area:
+            Container = AreaEffects;
+            break;
+    }
+    
+    return Container ? *Container : EmptyContainer;
+}
+
+TSharedRef<const FAbilityRuntimeDefinition, ESPMode::ThreadSafe> FAbilityRuntimeDefinition::Build(const FAbilityRowPtr& Row)
+{
+    check(Row.IsValid());
+    
+    TSharedRef<FAbilityRuntimeDefinition, ESPMode::ThreadSafe> Definition = MakeShared<FAbilityRuntimeDefinition, ESPMode::ThreadSafe>();
+    const FAbilityTableRow& AbilityRow = *Row;
+    
+    Definition->Row = Row;
+    Definition->AbilityID = AbilityRow.AbilityID;
+    Definition->AbilityType = AbilityRow.AbilityType;
+    Definition->CooldownTag = AbilityRow.CooldownTag;
+    Definition->IDCooldownTag = FAbilityCooldownTags::Resolve(AbilityRow.AbilityID);
+    Definition->Cooldown = AbilityRow.Cooldown;
+    Definition->CastTime = AbilityRow.CastTime;
+    Definition->ManaCost = AbilityRow.ManaCost;
+    Definition->RangeSquared = AbilityRow.MaxRange > 0.0f ? FMath::Square(AbilityRow.MaxRange) : 0.0f;
+    Definition->AreaEffectRadius = AbilityRow.AreaEffectRadius;
+    Definition->SelfEffects = &AbilityRow.SelfEffects;
+    Definition->TargetEffects = &AbilityRow.TargetEffects;
+    Definition->AreaEffects = &AbilityRow.AreaEffects;
+    
+    EAbilityDefinitionFlags Flags = EAbilityDefinitionFlags::None;
+    
+    if (AbilityRow.AbilityType == EAbilityType::Target || AbilityRow.AbilityType == EAbilityType::Cast)
+    {
+        Flags |= EAbilityDefinitionFlags::RequiresTarget;
+    }
+    
+    if (AbilityRow.AbilityType == EAbilityType::Friendly)
+    {
+        Flags |= EAbilityDefinitionFlags::Friendly;
+    }
+    
+    if (AbilityRow.CastTime > 0.0f)
+    {
+        Flags |= EAbilityDefinitionFlags::HasCastTime;
+    }
+    
+    if (AbilityRow.bCanCastWhileMoving)
+    {
+        Flags |= EAbilityDefinitionFlags::CanCastWhileMoving;
+    }
+    
+    if (AbilityRow.bUsesGlobalCooldown)
+    {
+        Flags |= EAbilityDefinitionFlags::UsesGlobalCooldown;
+    }
+    
+    if (AbilityRow.Cooldown > 0.0f)
+    {
+        Flags |= EAbilityDefinitionFlags::HasCooldown;
+    }
+    
+    if (AbilityRow.MaxRange > 0.0f)
+    {
+        Flags |= EAbilityDefinitionFlags::HasRange;
+    }
+    
+    if (AbilityRow.SelfEffects.EffectIDs.Num() > 0)
+    {
+        Flags |= EAbilityDefinitionFlags::HasSelfEffects;
+    }
+    
+    if (AbilityRow.TargetEffects.EffectIDs.Num() > 0)
+    {
+        Flags |= EAbilityDefinitionFlags::HasTargetEffects;
+    }
+    
+    if (AbilityRow.AreaEffects.EffectIDs.Num() > 0)
+    {
+        Flags |= EAbilityDefinitionFlags::HasAreaEffects;
+    }
+    
+    Definition->Flags = Flags;
+    return Definition;
+}
+
+const FPrimaryAssetType UAbilityDataAsset::PrimaryAssetType(TEXT("AbilityData"));
+
+FPrimaryAssetId UAbilityDataAsset::GetPrimaryAssetId() const
+{
+    return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
+
+void UAbilityDataAsset::PostLoad()
+{
+    Super::PostLoad();
+    
+    RebuildIndices();
+}
+
+void UAbilityDataAsset::BeginDestroy()
+{
+    UnbindDataTable();
+    
+    Super::BeginDestroy();
+}
+
+#if WITH_EDITOR
+void UAbilityDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    
+    if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UAbilityDataAsset, AbilityDataTable))
+    {
+        RebuildIndices();
+    }
+}
+
+void UAbilityDataAsset::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+    Super::PreSave(ObjectSaveContext);
+    
+    SourceChecksum = FCombatDatabase::ComputeSourceChecksum(this);
+}
+#endif
+
+void UAbilityDataAsset::UnbindDataTable()
+{
+    if (UDataTable* OldTable = IndexedDataTable.Get())
+    {
+        OldTable->OnDataTableChanged().Remove(DataTableChangedHandle);
+    }
+    
+    DataTableChangedHandle.Reset();
+    IndexedDataTable.Reset();
+}
+
+void UAbilityDataAsset::RebuildIndices()
+{
+    // Re-bind if the table itself was swapped
+    if (IndexedDataTable.Get() != AbilityDataTable)
+    {
+        UnbindDataTable();
+        
+        if (AbilityDataTable)
+        {
+            DataTableChangedHandle = AbilityDataTable->OnDataTableChanged().AddUObject(this, &UAbilityDataAsset::OnAbilityDataTableChanged);
+            IndexedDataTable = AbilityDataTable;
+        }
+    }
+    
+    const FAbilityDataSnapshot* PreviousSnapshot = CurrentSnapshot.Get();
+    
+    TSharedRef<FAbilityDataSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FAbilityDataSnapshot, ESPMode::ThreadSafe>();
+    NewSnapshot->Version = PreviousSnapshot ? PreviousSnapshot->Version + 1 : 1;
+    
+    int32 NumChangedRows = 0;
+    
+    if (AbilityDataTable)
+    {
+        TArray<FAbilityTableRow*> AllAbilities;
+        AbilityDataTable->GetAllRows(TEXT("RebuildIndices"), AllAbilities);
+        
+        NewSnapshot->Rows.Reserve(AllAbilities.Num());
+        NewSnapshot->Definitions.Reserve(AllAbilities.Num());
+        NewSnapshot->IDIndex.Reserve(AllAbilities.Num());
+        
+        const UScriptStruct* RowStruct = FAbilityTableRow::StaticStruct();
+        
+        for (const FAbilityTableRow* AbilityRow : AllAbilities)
+        {
+            if (!AbilityRow)
+            {
+                continue;
+            }
+            
+            // First row wins, same as the old linear scan
+            if (NewSnapshot->IDIndex.Contains(AbilityRow->AbilityID))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("%s: duplicate ability ID %d (%s) ignored"), 
+                    *GetName(), AbilityRow->AbilityID, *AbilityRow->DisplayName);
+                continue;
+            }
+            
+            // Share the previous copy when the row is unchanged so holders of the old snapshot and the new
+            // one point at the same memory
+            FAbilityRowPtr SharedRow = PreviousSnapshot ? PreviousSnapshot->FindSharedByID(AbilityRow->AbilityID) : FAbilityRowPtr();
+            FAbilityDefinitionPtr Definition;
+            if (!SharedRow.IsValid() || !RowStruct->CompareScriptStruct(SharedRow.Get(), AbilityRow, PPF_None))
+            {
+                SharedRow = MakeShared<FAbilityTableRow, ESPMode::ThreadSafe>(*AbilityRow);
+                Definition = FAbilityRuntimeDefinition::Build(SharedRow);
+                ++NumChangedRows;
+            }
+            else
+            {
+                Definition = PreviousSnapshot->FindDefinitionByID(AbilityRow->AbilityID);
+            }
+            
+            const int32 RowIndex = NewSnapshot->Rows.Add(SharedRow);
+            NewSnapshot->Definitions.Add(Definition);
+            NewSnapshot->IDIndex.Add(AbilityRow->AbilityID, RowIndex);
+            
+            if (!NewSnapshot->SlotIndex.Contains(AbilityRow->DefaultHotbarSlot))
+            {
+                NewSnapshot->SlotIndex.Add(AbilityRow->DefaultHotbarSlot, RowIndex);
+            }
+        }
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("%s: ability snapshot %u built, %d of %d rows changed"), 
+        *GetName(), NewSnapshot->Version, NumChangedRows, NewSnapshot->Rows.Num());
+    
+    SwapSnapshot(NewSnapshot);
+}
+
+void UAbilityDataAsset::PatchAbilityRows(const TArray<FAbilityTableRow>& ChangedRows)
+{
+    EnsureIndicesBuilt();
+    
+    if (ChangedRows.Num() == 0 || !CurrentSnapshot.IsValid())
+    {
+        return;
+    }
+    
+    // Copying the snapshot only copies row handles and the two index maps, rows themselves are shared
+    TSharedRef<FAbilityDataSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FAbilityDataSnapshot, ESPMode::ThreadSafe>(*CurrentSnapshot);
+    NewSnapshot->Version = CurrentSnapshot->Version + 1;
+    
+    bool bSlotsChanged = false;
+    
+    for (const FAbilityTableRow& ChangedRow : ChangedRows)
+    {
+        FAbilityRowPtr SharedRow = MakeShared<FAbilityTableRow, ESPMode::ThreadSafe>(ChangedRow);
+        
+        if (const int32* RowIndex = NewSnapshot->IDIndex.Find(ChangedRow.AbilityID))
+        {
+            bSlotsChanged |= NewSnapshot->Rows[*RowIndex]->DefaultHotbarSlot != ChangedRow.DefaultHotbarSlot;
+            NewSnapshot->Rows[*RowIndex] = SharedRow;
+            NewSnapshot->Definitions[*RowIndex] = FAbilityRuntimeDefinition::Build(SharedRow);
+        }
+        else
+        {
+            const int32 RowIndex = NewSnapshot->Rows.Add(SharedRow);
+            NewSnapshot->Definitions.Add(FAbilityRuntimeDefinition::Build(SharedRow));
+            NewSnapshot->IDIndex.Add(ChangedRow.AbilityID, RowIndex);
+            
+            if (!NewSnapshot->SlotIndex.Contains(ChangedRow.DefaultHotbarSlot))
+            {
+                NewSnapshot->SlotIndex.Add(ChangedRow.DefaultHotbarSlot, RowIndex);
+            }
+        }
+    }
+    
+    // Row indices never move, so the slot index only needs rebuilding when a row changed slot
+    if (bSlotsChanged)
+    {
+        NewSnapshot->RebuildSlotIndex();
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("%s: patched %d ability rows into snapshot %u"), 
+        *GetName(), ChangedRows.Num(), NewSnapshot->Version);
+    
+    SwapSnapshot(NewSnapshot);
+}
+
+void UAbilityDataAsset::SwapSnapshot(const TSharedRef<FAbilityDataSnapshot, ESPMode::ThreadSafe>& NewSnapshot)
+{
+    CurrentSnapshot = NewSnapshot;
+    
+    for (const FAbilityRowPtr& AbilityRow : NewSnapshot->Rows)
+    {
+        if (UClass* AbilityClass = AbilityRow->AbilityClass.Get())
+        {
+            ResolvedAbilityClasses.AddUnique(AbilityClass);
+        }
+    }
+    
+    FAbilityCooldownTags::Publish(*NewSnapshot);
+    
+    // Rows added by a reimport or patch need their icons streamed too
+    bPreloadIssued = false;
+    if (bPreloadRequested)
+    {
+        RequestAsyncPreload();
+    }
+    
+    OnSnapshotChanged.Broadcast(CurrentSnapshot);
+}
+
+void UAbilityDataAsset::RequestAsyncPreload()
+{
+    // Icons are presentation only
+    if (IsRunningDedicatedServer())
+    {
+        return;
+    }
+    
+    EnsureIndicesBuilt();
+    
+    // Already streaming this version of the table (called on every hotbar replication)
+    if (bPreloadIssued || !CurrentSnapshot.IsValid())
+    {
+        return;
+    }
+    
+    bPreloadRequested = true;
+    bPreloadIssued = true;
+    
+    TArray<FSoftObjectPath> PathsToStream;
+    for (const FAbilityRowPtr& AbilityRow : CurrentSnapshot->Rows)
+    {
+        const TSoftObjectPtr<UTexture2D>& Icon = AbilityRow->AbilityIcon;
+        if (!Icon.IsNull() && !Icon.Get())
+        {
+            PathsToStream.AddUnique(Icon.ToSoftObjectPath());
+        }
+    }
+    
+    if (PathsToStream.Num() == 0)
+    {
+        return;
+    }
+    
+    PruneHandles();
+    
+    TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        PathsToStream, FStreamableDelegate::CreateUObject(this, &UAbilityDataAsset::OnPreloadComplete));
+    if (Handle.IsValid())
+    {
+        PreloadHandles.Add(Handle);
+    }
+}
+
+void UAbilityDataAsset::OnPreloadComplete()
+{
+    PruneHandles();
+}
+
+void UAbilityDataAsset::PruneHandles()
+{
+    for (int32 Index = PreloadHandles.Num() - 1; Index >= 0; --Index)
+    {
+        const TSharedPtr<FStreamableHandle>& Handle = PreloadHandles[Index];
+        if (Handle.IsValid() && Handle->IsLoadingInProgress())
+        {
+            continue;
+        }
+        
+        if (Handle.IsValid() && Handle->HasLoadCompleted())
+        {
+            TArray<UObject*> LoadedAssets;
+            Handle->GetLoadedAssets(LoadedAssets);
+            
+            for (UObject* LoadedAsset : LoadedAssets)
+            {
+                if (LoadedAsset)
+                {
+                    PreloadedAssets.AddUnique(LoadedAsset);
+                }
+            }
+        }
+        
+        PreloadHandles.RemoveAtSwap(Index, 1, false);
+    }
+}
+
+#if WITH_EDITORONLY_DATA
+void UAbilityDataAsset::UpdateAssetBundleData()
+{
+    Super::UpdateAssetBundleData();
+    
     if (!AbilityDataTable)
     {
-        return false;
+        return;
     }
     
     TArray<FAbilityTableRow*> AllAbilities;
-    AbilityDataTable->GetAllRows(TEXT("GetAbilityDataBySlot"), AllAbilities);
+    AbilityDataTable->GetAllRows(TEXT("UpdateAssetBundleData"), AllAbilities);
     
-    for (FAbilityTableRow* AbilityRow : AllAbilities)
+    for (const FAbilityTableRow* AbilityRow : AllAbilities)
     {
-        if (AbilityRow && AbilityRow->DefaultHotbarSlot == SlotIndex)
+        if (AbilityRow && !AbilityRow->AbilityIcon.IsNull())
         {
-            OutAbilityData = *AbilityRow;
-            return true;
+            AssetBundleData.AddBundleAsset(ClientBundleName, AbilityRow->AbilityIcon.ToSoftObjectPath().GetAssetPath());
         }
     }
+}
+#endif
+
+void UAbilityDataAsset::OnAbilityDataTableChanged()
+{
+    RebuildIndices();
+}
+
+void UAbilityDataAsset::EnsureIndicesBuilt() const
+{
+    if (!CurrentSnapshot.IsValid() || IndexedDataTable.Get() != AbilityDataTable)
+    {
+        // The table was assigned at runtime, index it on first use
+        const_cast<UAbilityDataAsset*>(this)->RebuildIndices();
+    }
+}
+
+FAbilityDataSnapshotPtr UAbilityDataAsset::GetSnapshot() const
+{
+    EnsureIndicesBuilt();
+    
+    return CurrentSnapshot;
+}
+
+const FAbilityTableRow* UAbilityDataAsset::FindAbilityDataByID(int32 AbilityID) const
+{
+    EnsureIndicesBuilt();
+    
+    return CurrentSnapshot.IsValid() ? CurrentSnapshot->FindByID(AbilityID) : nullptr;
+}
+
+const FAbilityTableRow* UAbilityDataAsset::FindAbilityDataBySlot(int32 SlotIndex) const
+{
+    EnsureIndicesBuilt();
+    
+    return CurrentSnapshot.IsValid() ? CurrentSnapshot->FindBySlot(SlotIndex) : nullptr;
+}
+
+FAbilityRowPtr UAbilityDataAsset::FindSharedAbilityDataByID(int32 AbilityID) const
+{
+    EnsureIndicesBuilt();
+    
+    return CurrentSnapshot.IsValid() ? CurrentSnapshot->FindSharedByID(AbilityID) : FAbilityRowPtr();
+}
+
+FAbilityDefinitionPtr UAbilityDataAsset::FindAbilityDefinitionByID(int32 AbilityID) const
+{
+    EnsureIndicesBuilt();
+    
+    return CurrentSnapshot.IsValid() ? CurrentSnapshot->FindDefinitionByID(AbilityID) : FAbilityDefinitionPtr();
+}
+
+bool UAbilityDataAsset::GetAbilityDataByID(int32 AbilityID, FAbilityTableRow& OutAbilityData) const
+{
+    const FAbilityTableRow* AbilityRow = FindAbilityDataByID(AbilityID);
+    if (!AbilityRow)
+    {
+        return false;
+    }
     
-    return false;
-}
\ No newline at end of file
+    OutAbilityData = *AbilityRow;
+    return true;
+}
+
+bool UAbilityDataAsset::GetAbilityDataBySlot(int32 SlotIndex, FAbilityTableRow& OutAbilityData) const
+{
+    const FAbilityTableRow* AbilityRow = FindAbilityDataBySlot(SlotIndex);
+    if (!AbilityRow)
+    {
+        return false;
+    }
+    
+    OutAbilityData = *AbilityRow;
+    return true;
+}
@@ -9,6 +9,8 @@
 
 class UGameplayAbility;
 class UTexture2D;
+struct FStreamableHandle;
+class FObjectPreSaveContext;
 
 UENUM(BlueprintType)
 enum class EAbilityType : uint8
@@ -38,9 +40,9 @@ struct FAbilityTableRow : public FTableRowBase
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability")
     FString Description;
     
-    // Icon for the hotbar
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability")
-    UTexture2D* AbilityIcon;
+    // Icon for the hotbar (client-only, never loaded on a dedicated server)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability", meta = (AssetBundles = "Client"))
+    TSoftObjectPtr<UTexture2D> AbilityIcon;
     
     // The actual ability class to spawn
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability")
@@ -106,7 +108,6 @@ struct FAbilityTableRow : public FTableRowBase
         : AbilityID(0)
         , DisplayName("")
         , Description("")
-        , AbilityIcon(nullptr)
         , AbilityClass(nullptr)
         , AbilityType(EAbilityType::Instant)
         , ManaCost(0.0f)
@@ -121,12 +122,132 @@ struct FAbilityTableRow : public FTableRowBase
     }
 };
 
+// Shared, immutable copy of one ability row. Holding one keeps the row alive across table reloads
+typedef TSharedPtr<const FAbilityTableRow, ESPMode::ThreadSafe> FAbilityRowPtr;
+
+struct FAbilityDataSnapshot;
+
+// Per-ability "Ability.Cooldown.ID.<AbilityID>" tags, resolved once when the ability table loads and
+// published as an immutable array indexed by AbilityID, so cooldown checks never format or look up a
+// tag name and never take a lock
+struct MYPROJECT5_API FAbilityCooldownTags
+{
+    // IDs above this are not tracked (and warned about) rather than growing the array
+    static constexpr int32 MaxAbilityID = 65535;
+    
+    // Resolve the tag for an ID against the tag dictionary. Invalid if the tag is not defined
+    static FGameplayTag Resolve(int32 AbilityID);
+    
+    // Publish a new table with every definition's tag from Snapshot added. Game thread only
+    static void Publish(const FAbilityDataSnapshot& Snapshot);
+    
+    // The published tag for an ID, invalid if it was never published or is not defined. Safe from any thread
+    static FGameplayTag Find(int32 AbilityID);
+};
+
+// Row properties the activation path branches on, resolved once per row
+enum class EAbilityDefinitionFlags : uint16
+{
+    None                = 0,
+    RequiresTarget      = 1 << 0,   // Target or Cast
+    Friendly            = 1 << 1,
+    HasCastTime         = 1 << 2,
+    CanCastWhileMoving  = 1 << 3,
+    UsesGlobalCooldown  = 1 << 4,
+    HasCooldown         = 1 << 5,
+    HasRange            = 1 << 6,
+    HasSelfEffects      = 1 << 7,
+    HasTargetEffects    = 1 << 8,
+    HasAreaEffects      = 1 << 9
+};
+ENUM_CLASS_FLAGS(EAbilityDefinitionFlags);
+
+// Runtime form of one ability row, built once per row version and shared by every granted instance.
+// Immutable; the container pointers point into Row, which the definition keeps alive
+struct MYPROJECT5_API FAbilityRuntimeDefinition
+{
+    FAbilityRowPtr Row;
+    
+    int32 AbilityID = 0;
+    
+    EAbilityType AbilityType = EAbilityType::Instant;
+    
+    EAbilityDefinitionFlags Flags = EAbilityDefinitionFlags::None;
+    
+    // The row's cooldown tag (may be invalid)
+    FGameplayTag CooldownTag;
+    
+    // "Ability.Cooldown.ID.<AbilityID>", invalid if the project does not define it
+    FGameplayTag IDCooldownTag;
+    
+    float Cooldown = 0.0f;
+    float CastTime = 0.0f;
+    float ManaCost = 0.0f;
+    
+    // MaxRange squared, 0 when the ability has no range limit
+    float RangeSquared = 0.0f;
+    
+    float AreaEffectRadius = 0.0f;
+    
+    const FEffectContainerSpec* SelfEffects = nullptr;
+    const FEffectContainerSpec* TargetEffects = nullptr;
+    const FEffectContainerSpec* AreaEffects = nullptr;
+    
+    bool HasFlag(EAbilityDefinitionFlags Flag) const { return EnumHasAnyFlags(Flags, Flag); }
+    
+    // Container for a type, never null
+    const FEffectContainerSpec& GetEffectContainer(EEffectContainerType ContainerType) const;
+    
+    // Resolve everything from a row. Row must be valid
+    static TSharedRef<const FAbilityRuntimeDefinition, ESPMode::ThreadSafe> Build(const FAbilityRowPtr& Row);
+};
+
+typedef TSharedPtr<const FAbilityRuntimeDefinition, ESPMode::ThreadSafe> FAbilityDefinitionPtr;
+
+// Immutable view of the ability table at one point in time.
+// A reload builds a new snapshot that shares every unchanged row with the previous one, so anything
+// still holding the old snapshot or one of its rows (in-flight casts, hotbar slots) stays valid.
+struct MYPROJECT5_API FAbilityDataSnapshot
+{
+    // Incremented every time the asset swaps in a new snapshot
+    uint32 Version = 0;
+    
+    // Rows in table order
+    TArray<FAbilityRowPtr> Rows;
+    
+    // Runtime definitions, parallel to Rows and shared along with them
+    TArray<FAbilityDefinitionPtr> Definitions;
+    
+    // AbilityID -> index into Rows
+    TMap<int32, int32> IDIndex;
+    
+    // DefaultHotbarSlot -> index of the first row using that slot
+    TMap<int32, int32> SlotIndex;
+    
+    const FAbilityTableRow* FindByID(int32 AbilityID) const;
+    FAbilityRowPtr FindSharedByID(int32 AbilityID) const;
+    FAbilityDefinitionPtr FindDefinitionByID(int32 AbilityID) const;
+    const FAbilityTableRow* FindBySlot(int32 SlotIndex) const;
+    
+    // Rebuild SlotIndex from Rows after a row moved slot
+    void RebuildSlotIndex();
+};
+
+typedef TSharedPtr<const FAbilityDataSnapshot, ESPMode::ThreadSafe> FAbilityDataSnapshotPtr;
+
+// Broadcast on the game thread after a new snapshot has been swapped in
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnAbilityDataSnapshotChanged, const FAbilityDataSnapshotPtr& /*NewSnapshot*/);
+
+// Primary asset so the Asset Manager can manage and stream the ability table alongside the effect table
 UCLASS()
-class MYPROJECT5_API UAbilityDataAsset : public UDataAsset
+class MYPROJECT5_API UAbilityDataAsset : public UPrimaryDataAsset
 {
     GENERATED_BODY()
     
 public:
+    // Primary asset type every ability data asset is registered under
+    static const FPrimaryAssetType PrimaryAssetType;
+    
     // The data table containing ability definitions
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Abilities")
     UDataTable* AbilityDataTable;
@@ -138,4 +259,99 @@ public:
     // Get ability data by slot
     UFUNCTION(BlueprintCallable, Category = "Abilities")
     bool GetAbilityDataBySlot(int32 SlotIndex, FAbilityTableRow& OutAbilityData) const;
+    
+    // Get a pointer to the ability row by ID without copying it (nullptr if not found).
+    // Only valid until the next snapshot swap; use FindSharedAbilityDataByID to keep the row
+    const FAbilityTableRow* FindAbilityDataByID(int32 AbilityID) const;
+    
+    // Get a pointer to the ability row by default hotbar slot without copying it
+    const FAbilityTableRow* FindAbilityDataBySlot(int32 SlotIndex) const;
+    
+    // Get a reference-counted handle to the ability row that survives table reloads
+    FAbilityRowPtr FindSharedAbilityDataByID(int32 AbilityID) const;
+    
+    // Get the shared runtime definition for an ability (null if not found). Abilities resolve this once when granted
+    FAbilityDefinitionPtr FindAbilityDefinitionByID(int32 AbilityID) const;
+    
+    // The current snapshot. Callers that need a consistent view across several lookups should hold on to it
+    FAbilityDataSnapshotPtr GetSnapshot() const;
+    
+    // Rebuild the snapshot from the data table, reusing every row that did not change
+    void RebuildIndices();
+    
+    // Live hotfix: swap in a snapshot where only these rows (matched by AbilityID) are replaced or added.
+    // The data table itself is left untouched, so a later reimport wins
+    void PatchAbilityRows(const TArray<FAbilityTableRow>& ChangedRows);
+    
+    // Fired after every snapshot swap
+    FOnAbilityDataSnapshotChanged OnSnapshotChanged;
+    
+    // Stream the client-only presentation assets (icons). Does nothing on a dedicated server
+    void RequestAsyncPreload();
+    
+    virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+    virtual void PostLoad() override;
+    virtual void BeginDestroy() override;
+    
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+    
+    // Stamp SourceChecksum from the current table, so cooked assets carry it
+    virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+#endif
+    
+    // Checksum of the table's gameplay fields when this asset was last saved or cooked (0 if never).
+    // The combat database stores the same value for the table it was built from
+    uint32 GetSourceChecksum() const { return SourceChecksum; }
+
+#if WITH_EDITORONLY_DATA
+    // Put row icons in the "Client" bundle so a server loading only gameplay bundles never pulls them in
+    virtual void UpdateAssetBundleData() override;
+#endif
+
+protected:
+    UPROPERTY(VisibleAnywhere, AssetRegistrySearchable, Category = "Abilities")
+    uint32 SourceChecksum = 0;
+    
+    // Rebuild the indices if the data table was swapped since the last build
+    void EnsureIndicesBuilt() const;
+    
+    // Called whenever rows are added, removed or reimported on the bound table
+    void OnAbilityDataTableChanged();
+    
+    // Stop listening to the table the indices were built from
+    void UnbindDataTable();
+    
+    // Publish a new snapshot. Runs on the game thread (or during PostLoad, before anyone can read it)
+    void SwapSnapshot(const TSharedRef<FAbilityDataSnapshot, ESPMode::ThreadSafe>& NewSnapshot);
+    
+    // Called when an icon preload finishes streaming
+    void OnPreloadComplete();
+    
+    // Drop finished and cancelled handles, moving what finished ones loaded into PreloadedAssets
+    void PruneHandles();
+    
+    // Current snapshot; replaced wholesale, never modified once published
+    FAbilityDataSnapshotPtr CurrentSnapshot;
+    
+    // Every ability class a snapshot row has referenced. The rows are heap copies GC cannot see, so the
+    // classes are kept here
+    UPROPERTY(Transient)
+    TArray<UClass*> ResolvedAbilityClasses;
+    
+    // The table the snapshot was built from
+    TWeakObjectPtr<UDataTable> IndexedDataTable;
+    
+    FDelegateHandle DataTableChangedHandle;
+    
+    // Requests still streaming
+    TArray<TSharedPtr<FStreamableHandle>> PreloadHandles;
+    
+    // Every icon a finished preload loaded, kept resident for as long as this asset lives
+    UPROPERTY(Transient)
+    TArray<UObject*> PreloadedAssets;
+    
+    // Remember the request so a table reimport streams the new icons too
+    bool bPreloadRequested = false;
+    bool bPreloadIssued = false;
 };
\ No newline at end of file
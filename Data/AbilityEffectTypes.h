@@ -9,6 +9,10 @@
 #include "Sound/SoundBase.h" // Add this for sound
 #include "AbilityEffectTypes.generated.h"
 
+class FEffectFormula;
+class UAbilitySystemComponent;
+struct FLevelScalingTable;
+
 // Enumeration for basic effect types
 UENUM(BlueprintType)
 enum class EEffectType : uint8
@@ -68,7 +72,12 @@ struct FEffectScalingInfo
         meta = (EditCondition = "MagnitudeType == EEffectMagnitudeType::ScaledByStat"))
     FGameplayTag StatTag;
     
-    // For custom formulas - name of the formula to use
+    // Row in the effect asset's ScalingCurves used in place of the raw level (None = linear in level)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect|Scaling", 
+        meta = (EditCondition = "MagnitudeType == EEffectMagnitudeType::ScaledByLevel"))
+    FName LevelCurve;
+    
+    // For custom formulas - name of an entry in UEffectDataAsset::CustomFormulas, or the expression itself
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect|Scaling", 
         meta = (EditCondition = "MagnitudeType == EEffectMagnitudeType::Custom"))
     FName CustomFormula;
@@ -123,7 +132,7 @@ struct FEffectTableRow : public FTableRowBase
     FGameplayTag AffectedAttributeTag;
     
     // Gameplay effect class to use
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect", meta = (AssetBundles = "Gameplay"))
     TSoftClassPtr<class UGameplayEffect> GameplayEffectClass;
     
     // Required application tags (target must have these)
@@ -139,22 +148,162 @@ struct FEffectTableRow : public FTableRowBase
     FGameplayTagContainer GrantedTags;
     
     // Effect application VFX
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect|Visuals")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect|Visuals", meta = (AssetBundles = "Client"))
     TSoftObjectPtr<class UNiagaraSystem> ApplicationVFX;
     
     // Effect persistent VFX (for duration effects)
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect|Visuals")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect|Visuals", meta = (AssetBundles = "Client"))
     TSoftObjectPtr<class UNiagaraSystem> PersistentVFX;
     
     // Sound to play on application
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect|Audio")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect|Audio", meta = (AssetBundles = "Client"))
     TSoftObjectPtr<class USoundBase> ApplicationSound;
     
     // Persistent sound for duration effects
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect|Audio")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Effect|Audio", meta = (AssetBundles = "Client"))
     TSoftObjectPtr<class USoundBase> PersistentSound;
 };
 
+// Flags packed into a compiled effect record
+enum class EEffectRecordFlags : uint32
+{
+    None                = 0,
+    HasDuration         = 1 << 0,   // DurationType == Duration
+    Permanent           = 1 << 1,   // DurationType == Permanent
+    Periodic            = 1 << 2,   // TickPeriod > 0
+    Damage              = 1 << 3,   // Damage or DamageOverTime
+    Healing             = 1 << 4,   // Healing or HealingOverTime
+    NegateMagnitude     = 1 << 5,   // SetByCaller value is applied as a negative number
+    HasRequiredTags     = 1 << 6,
+    HasForbiddenTags    = 1 << 7,
+    HasStatScaling      = 1 << 8    // Magnitude scales from a resolved stat attribute
+};
+ENUM_CLASS_FLAGS(EEffectRecordFlags);
+
+// Process-wide index space for AdditionalMagnitudes names, filled as effect tables are compiled.
+// Indices never change once assigned, so gameplay code can resolve "Slow" once and keep the int
+struct MYPROJECT5_API FEffectMagnitudeNames
+{
+    // Index for a name, assigning the next free one if it is new
+    static int32 Intern(FName Name);
+    
+    // Index for a name, INDEX_NONE if no effect table has used it
+    static int32 Find(FName Name);
+    
+    // Name for an index, NAME_None if out of range
+    static FName GetName(int32 NameIndex);
+};
+
+// One compiled magnitude (the primary one, or an entry of AdditionalMagnitudes)
+struct FCompiledEffectMagnitude
+{
+    // Interned AdditionalMagnitudes name, INDEX_NONE for the primary magnitude
+    int32 NameIndex = INDEX_NONE;
+    
+    EEffectMagnitudeType MagnitudeType = EEffectMagnitudeType::Flat;
+    float BaseValue = 0.0f;
+    float ScalingCoefficient = 1.0f;
+    
+    // Attribute named by StatTag (invalid if unresolved)
+    FGameplayAttribute StatAttribute;
+    
+    // Baked LevelCurve for ScaledByLevel (null = linear in level)
+    TSharedPtr<const FLevelScalingTable, ESPMode::ThreadSafe> LevelCurve;
+    
+    // Compiled expression for EEffectMagnitudeType::Custom (null if the formula failed to compile)
+    TSharedPtr<const FEffectFormula, ESPMode::ThreadSafe> Formula;
+};
+
+// RequiredTargetTags / ForbiddenTargetTags flattened when the table is compiled and tested straight against
+// the target ASC's tag count map, so checking a target never copies its owned tags. Parent tags match the
+// same way as HasAll / HasAny on the owned tag container
+struct MYPROJECT5_API FCompiledTagRequirements
+{
+    // Required tags, minus any implied by a more specific required tag
+    TArray<FGameplayTag, TInlineAllocator<2>> RequiredTags;
+    
+    // Forbidden tags, minus any whose parent is already forbidden
+    TArray<FGameplayTag, TInlineAllocator<2>> ForbiddenTags;
+    
+    void Compile(const FGameplayTagContainer& Required, const FGameplayTagContainer& Forbidden);
+    
+    bool IsEmpty() const { return RequiredTags.Num() == 0 && ForbiddenTags.Num() == 0; }
+    
+    // Target has every required tag
+    bool HasRequiredTags(const UAbilitySystemComponent& TargetASC) const;
+    
+    // Target has at least one forbidden tag
+    bool HasForbiddenTags(const UAbilitySystemComponent& TargetASC) const;
+    
+    bool Matches(const UAbilitySystemComponent& TargetASC) const
+    {
+        return HasRequiredTags(TargetASC) && !HasForbiddenTags(TargetASC);
+    }
+    
+    // Batch form for area effects: appends the indices of the targets that pass, in order. Null ASCs fail.
+    // Returns the number of passing targets
+    int32 FilterTargets(TArrayView<const UAbilitySystemComponent* const> TargetASCs, TArray<int32>& OutPassingIndices) const;
+};
+
+// Runtime form of FEffectTableRow, compiled once when the effect table is indexed.
+// Everything the apply path needs is pre-resolved so it does no tag or asset lookups.
+USTRUCT()
+struct FCompiledEffectRecord
+{
+    GENERATED_BODY()
+    
+    int32 EffectID = 0;
+    
+    EEffectType EffectType = EEffectType::Damage;
+    
+    EEffectRecordFlags Flags = EEffectRecordFlags::None;
+    
+    float Duration = 0.0f;
+    
+    float TickPeriod = 0.0f;
+    
+    // Primary magnitude
+    FCompiledEffectMagnitude Magnitude;
+    
+    // AdditionalMagnitudes flattened and sorted by NameIndex. Most effects have one or two, kept inline
+    TArray<FCompiledEffectMagnitude, TInlineAllocator<2>> AdditionalMagnitudes;
+    
+    // Resolved gameplay effect class and its CDO (null until the class is loaded)
+    UPROPERTY(Transient)
+    TSubclassOf<UGameplayEffect> GameplayEffectClass;
+    
+    const UGameplayEffect* GameplayEffectCDO = nullptr;
+    
+    // Data.Damage / Data.Healing / Data.Magnitude depending on the effect type
+    UPROPERTY(Transient)
+    FGameplayTag SetByCallerTag;
+    
+    // Attribute named by AffectedAttributeTag
+    UPROPERTY(Transient)
+    FGameplayAttribute AffectedAttribute;
+    
+    // Compiled RequiredTargetTags / ForbiddenTargetTags
+    FCompiledTagRequirements TargetRequirements;
+    
+    // Source row for tags, cosmetics and additional magnitudes
+    const FEffectTableRow* SourceRow = nullptr;
+    
+    bool HasFlag(EEffectRecordFlags Flag) const { return EnumHasAnyFlags(Flags, Flag); }
+    
+    // Secondary magnitude by interned name index, nullptr if this effect does not have it
+    const FCompiledEffectMagnitude* FindAdditionalMagnitude(int32 NameIndex) const
+    {
+        for (const FCompiledEffectMagnitude& Entry : AdditionalMagnitudes)
+        {
+            if (Entry.NameIndex >= NameIndex)
+            {
+                return Entry.NameIndex == NameIndex ? &Entry : nullptr;
+            }
+        }
+        return nullptr;
+    }
+};
+
 // Container for a collection of effects to apply
 USTRUCT(BlueprintType)
 struct FEffectContainerSpec
@@ -0,0 +1,42 @@
+// File: BuildCombatDatabaseCommandlet.cpp
+#include "BuildCombatDatabaseCommandlet.h"
+#include "AbilityDataAsset.h"
+#include "EffectDataAsset.h"
+#include "CombatDatabase.h"
+
+UBuildCombatDatabaseCommandlet::UBuildCombatDatabaseCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UBuildCombatDatabaseCommandlet::Main(const FString& Params)
+{
+    FString AbilitiesPath;
+    FString EffectsPath;
+    FString OutputPath = FCombatDatabase::GetDefaultPath();
+    
+    FParse::Value(*Params, TEXT("Abilities="), AbilitiesPath);
+    FParse::Value(*Params, TEXT("Effects="), EffectsPath);
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+    
+    UAbilityDataAsset* AbilityData = LoadObject<UAbilityDataAsset>(nullptr, *AbilitiesPath);
+    UEffectDataAsset* EffectData = LoadObject<UEffectDataAsset>(nullptr, *EffectsPath);
+    
+    if (!AbilityData || !EffectData)
+    {
+        UE_LOG(LogTemp, Error, TEXT("BuildCombatDatabase: could not load -Abilities=%s / -Effects=%s"), *AbilitiesPath, *EffectsPath);
+        return 1;
+    }
+    
+    if (!FCombatDatabase::WriteToFile(AbilityData, EffectData, OutputPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("BuildCombatDatabase: failed to write %s"), *OutputPath);
+        return 1;
+    }
+    
+    UE_LOG(LogTemp, Display, TEXT("BuildCombatDatabase: wrote %s"), *OutputPath);
+    return 0;
+}
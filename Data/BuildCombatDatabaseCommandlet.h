@@ -0,0 +1,19 @@
+// File: BuildCombatDatabaseCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BuildCombatDatabaseCommandlet.generated.h"
+
+// Cook step that writes the ability and effect tables into the binary combat database.
+// Usage: -run=BuildCombatDatabase -Abilities=/Game/Data/DA_Abilities.DA_Abilities -Effects=/Game/Data/DA_Effects.DA_Effects [-Output=Path]
+UCLASS()
+class MYPROJECT5_API UBuildCombatDatabaseCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+    
+public:
+    UBuildCombatDatabaseCommandlet();
+    
+    virtual int32 Main(const FString& Params) override;
+};
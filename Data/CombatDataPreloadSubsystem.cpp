@@ -0,0 +1,128 @@
+// File: CombatDataPreloadSubsystem.cpp
+#include "CombatDataPreloadSubsystem.h"
+#include "AbilityDataAsset.h"
+#include "EffectDataAsset.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+
+namespace
+{
+    // Bundles filled in by the data assets' UpdateAssetBundleData
+    const FName GameplayBundleName(TEXT("Gameplay"));
+    const FName ClientBundleName(TEXT("Client"));
+}
+
+UCombatDataPreloadSubsystem::UCombatDataPreloadSubsystem()
+{
+    CombatDataDirectories.Add(TEXT("/Game/Data"));
+}
+
+bool UCombatDataPreloadSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatDataPreloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (!UAssetManager::IsInitialized())
+    {
+        return;
+    }
+
+    RegisterPrimaryAssetTypes();
+
+    UAssetManager& AssetManager = UAssetManager::Get();
+
+    TArray<FPrimaryAssetId> AssetIds;
+    AssetManager.GetPrimaryAssetIdList(UAbilityDataAsset::PrimaryAssetType, AssetIds);
+    AssetManager.GetPrimaryAssetIdList(UEffectDataAsset::PrimaryAssetType, AssetIds);
+
+    if (AssetIds.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("No ability or effect data assets found to preload"));
+        return;
+    }
+
+    TArray<FName> Bundles;
+    Bundles.Add(GameplayBundleName);
+    if (!IsRunningDedicatedServer())
+    {
+        Bundles.Add(ClientBundleName);
+    }
+
+    PreloadHandle = AssetManager.LoadPrimaryAssets(AssetIds, Bundles,
+        FStreamableDelegate::CreateUObject(this, &UCombatDataPreloadSubsystem::OnPrimaryAssetsLoaded),
+        FStreamableManager::AsyncLoadHighPriority);
+
+    // Nothing to stream when everything is already in memory
+    if (!PreloadHandle.IsValid())
+    {
+        OnPrimaryAssetsLoaded();
+    }
+}
+
+void UCombatDataPreloadSubsystem::Deinitialize()
+{
+    // The asset manager keeps the assets loaded for the next map, only our handle goes
+    PreloadHandle.Reset();
+
+    Super::Deinitialize();
+}
+
+bool UCombatDataPreloadSubsystem::IsPreloading() const
+{
+    return PreloadHandle.IsValid() && PreloadHandle->IsLoadingInProgress();
+}
+
+void UCombatDataPreloadSubsystem::RegisterPrimaryAssetTypes() const
+{
+    UAssetManager& AssetManager = UAssetManager::Get();
+
+    FPrimaryAssetTypeInfo TypeInfo;
+    if (!AssetManager.GetPrimaryAssetTypeInfo(UAbilityDataAsset::PrimaryAssetType, TypeInfo))
+    {
+        AssetManager.ScanPathsForPrimaryAssets(UAbilityDataAsset::PrimaryAssetType, CombatDataDirectories, UAbilityDataAsset::StaticClass(), false, false, true);
+    }
+
+    if (!AssetManager.GetPrimaryAssetTypeInfo(UEffectDataAsset::PrimaryAssetType, TypeInfo))
+    {
+        AssetManager.ScanPathsForPrimaryAssets(UEffectDataAsset::PrimaryAssetType, CombatDataDirectories, UEffectDataAsset::StaticClass(), false, false, true);
+    }
+}
+
+void UCombatDataPreloadSubsystem::OnPrimaryAssetsLoaded()
+{
+    // The asset manager may also run the delegate when it had nothing to stream
+    if (bAssetsLoaded)
+    {
+        return;
+    }
+
+    bAssetsLoaded = true;
+
+    UAssetManager& AssetManager = UAssetManager::Get();
+
+    TArray<UObject*> LoadedAssets;
+    AssetManager.GetPrimaryAssetObjectList(UEffectDataAsset::PrimaryAssetType, LoadedAssets);
+    for (UObject* LoadedAsset : LoadedAssets)
+    {
+        if (UEffectDataAsset* EffectData = Cast<UEffectDataAsset>(LoadedAsset))
+        {
+            EffectData->RequestAsyncPreload(!IsRunningDedicatedServer());
+        }
+    }
+
+    LoadedAssets.Reset();
+    AssetManager.GetPrimaryAssetObjectList(UAbilityDataAsset::PrimaryAssetType, LoadedAssets);
+    for (UObject* LoadedAsset : LoadedAssets)
+    {
+        if (UAbilityDataAsset* AbilityData = Cast<UAbilityDataAsset>(LoadedAsset))
+        {
+            AbilityData->RequestAsyncPreload();
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Combat data assets loaded for %s"), *GetWorld()->GetMapName());
+}
@@ -0,0 +1,43 @@
+// File: CombatDataPreloadSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatDataPreloadSubsystem.generated.h"
+
+struct FStreamableHandle;
+
+// Starts streaming every ability and effect data asset, with their bundles, as soon as a game world is
+// initialized for a map, so the tables are loaded before any character begins play.
+// Dedicated servers load only the "Gameplay" bundle; everyone else also loads the "Client" bundle.
+// The asset manager finds the assets through their primary asset types, scanned from CombatDataDirectories
+UCLASS(Config = Game)
+class MYPROJECT5_API UCombatDataPreloadSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UCombatDataPreloadSubsystem();
+
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // True while the map's data assets are still streaming
+    bool IsPreloading() const;
+
+protected:
+    // Register the data asset primary asset types with the asset manager if nothing has yet
+    void RegisterPrimaryAssetTypes() const;
+
+    // Hand the loaded assets their own preload so records resolve their classes
+    void OnPrimaryAssetsLoaded();
+
+    // Content directories holding the ability and effect data assets
+    UPROPERTY(Config)
+    TArray<FString> CombatDataDirectories;
+
+    TSharedPtr<FStreamableHandle> PreloadHandle;
+
+    bool bAssetsLoaded = false;
+};
@@ -0,0 +1,536 @@
+// File: CombatDatabase.cpp
+#include "CombatDatabase.h"
+#include "AbilityDataAsset.h"
+#include "EffectDataAsset.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/StableSort.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Crc.h"
+
+namespace
+{
+    // Accumulates the payload sections while building a file image
+    struct FCombatDatabaseWriter
+    {
+        TArray<FCombatAbilityRecord> Abilities;
+        TArray<FCombatEffectRecord> Effects;
+        TArray<FCombatMagnitudeRecord> Magnitudes;
+        TArray<uint32> IndexPool;
+        TArray<uint8> Strings;
+        TMap<FString, uint32> StringOffsets;
+
+        uint32 AddString(const FString& Value)
+        {
+            if (Value.IsEmpty())
+            {
+                return CombatDatabase::NoString;
+            }
+
+            if (const uint32* Existing = StringOffsets.Find(Value))
+            {
+                return *Existing;
+            }
+
+            const uint32 Offset = Strings.Num();
+            FTCHARToUTF8 Utf8(*Value);
+            Strings.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+            Strings.Add(0);
+
+            StringOffsets.Add(Value, Offset);
+            return Offset;
+        }
+
+        uint32 AddName(FName Value)
+        {
+            return Value.IsNone() ? CombatDatabase::NoString : AddString(Value.ToString());
+        }
+
+        void AddEffectIDs(const FEffectContainerSpec& Container, uint32& OutStart, uint32& OutCount)
+        {
+            OutStart = IndexPool.Num();
+            OutCount = Container.EffectIDs.Num();
+
+            for (int32 EffectID : Container.EffectIDs)
+            {
+                IndexPool.Add(static_cast<uint32>(EffectID));
+            }
+        }
+
+        void AddTags(const FGameplayTagContainer& Tags, uint32& OutStart, uint32& OutCount)
+        {
+            OutStart = IndexPool.Num();
+            OutCount = Tags.Num();
+
+            for (const FGameplayTag& Tag : Tags)
+            {
+                IndexPool.Add(AddName(Tag.GetTagName()));
+            }
+        }
+    };
+
+    template <typename RecordType>
+    void AppendSection(TArray<uint8>& Bytes, int32 PayloadStart, const TArray<RecordType>& Records, uint32& OutOffset, uint32& OutCount)
+    {
+        OutOffset = Bytes.Num() - PayloadStart;
+        OutCount = Records.Num();
+        Bytes.Append(reinterpret_cast<const uint8*>(Records.GetData()), Records.Num() * sizeof(RecordType));
+    }
+
+    void WriteAbilities(FCombatDatabaseWriter& Writer, const UAbilityDataAsset& AbilityData)
+    {
+        // Sorted by ID for binary search. Stable so the first of any duplicate wins, like the asset index
+        TArray<FAbilityTableRow*> AllAbilities;
+        AbilityData.AbilityDataTable->GetAllRows(TEXT("CombatDatabase"), AllAbilities);
+        AllAbilities.RemoveAll([](const FAbilityTableRow* Row) { return Row == nullptr; });
+        Algo::StableSortBy(AllAbilities, &FAbilityTableRow::AbilityID);
+
+        for (const FAbilityTableRow* Row : AllAbilities)
+        {
+            if (Writer.Abilities.Num() > 0 && Writer.Abilities.Last().AbilityID == Row->AbilityID)
+            {
+                continue;
+            }
+
+            FCombatAbilityRecord Record;
+            FMemory::Memzero(Record);
+
+            Record.AbilityID = Row->AbilityID;
+            Record.AbilityType = static_cast<uint8>(Row->AbilityType);
+            Record.bCanCastWhileMoving = Row->bCanCastWhileMoving ? 1 : 0;
+            Record.bUsesGlobalCooldown = Row->bUsesGlobalCooldown ? 1 : 0;
+            Record.ManaCost = Row->ManaCost;
+            Record.Cooldown = Row->Cooldown;
+            Record.CastTime = Row->CastTime;
+            Record.MaxRange = Row->MaxRange;
+            Record.AreaEffectRadius = Row->AreaEffectRadius;
+            Record.DefaultHotbarSlot = Row->DefaultHotbarSlot;
+            Record.CooldownTag = Writer.AddName(Row->CooldownTag.GetTagName());
+            Record.AbilityClassPath = Row->AbilityClass ? Writer.AddString(Row->AbilityClass->GetPathName()) : CombatDatabase::NoString;
+            Writer.AddTags(Row->AbilityTags, Record.AbilityTagsStart, Record.AbilityTagsCount);
+            Writer.AddEffectIDs(Row->SelfEffects, Record.SelfEffectsStart, Record.SelfEffectsCount);
+            Writer.AddEffectIDs(Row->TargetEffects, Record.TargetEffectsStart, Record.TargetEffectsCount);
+            Writer.AddEffectIDs(Row->AreaEffects, Record.AreaEffectsStart, Record.AreaEffectsCount);
+
+            Writer.Abilities.Add(Record);
+        }
+    }
+
+    void WriteEffects(FCombatDatabaseWriter& Writer, const UEffectDataAsset& EffectData)
+    {
+        // Sorted by ID for binary search, first of any duplicate wins
+        TArray<FEffectTableRow*> AllEffects;
+        EffectData.EffectsDataTable->GetAllRows<FEffectTableRow>(TEXT("CombatDatabase"), AllEffects);
+        AllEffects.RemoveAll([](const FEffectTableRow* Row) { return Row == nullptr; });
+        Algo::StableSortBy(AllEffects, &FEffectTableRow::EffectID);
+
+        for (const FEffectTableRow* Row : AllEffects)
+        {
+            if (Writer.Effects.Num() > 0 && Writer.Effects.Last().EffectID == Row->EffectID)
+            {
+                continue;
+            }
+
+            FCombatEffectRecord Record;
+            FMemory::Memzero(Record);
+
+            Record.EffectID = Row->EffectID;
+            Record.EffectType = static_cast<uint8>(Row->EffectType);
+            Record.DurationType = static_cast<uint8>(Row->DurationType);
+            Record.MagnitudeType = static_cast<uint8>(Row->Magnitude.MagnitudeType);
+            Record.Duration = Row->Duration;
+            Record.TickPeriod = Row->TickPeriod;
+            Record.BaseValue = Row->Magnitude.BaseValue;
+            Record.ScalingCoefficient = Row->Magnitude.ScalingCoefficient;
+            Record.StatTag = Writer.AddName(Row->Magnitude.StatTag.GetTagName());
+            Record.CustomFormula = Writer.AddName(Row->Magnitude.CustomFormula);
+            Record.AffectedAttributeTag = Writer.AddName(Row->AffectedAttributeTag.GetTagName());
+            Record.GameplayEffectClassPath = Writer.AddString(Row->GameplayEffectClass.ToSoftObjectPath().ToString());
+            Writer.AddTags(Row->RequiredTargetTags, Record.RequiredTagsStart, Record.RequiredTagsCount);
+            Writer.AddTags(Row->ForbiddenTargetTags, Record.ForbiddenTagsStart, Record.ForbiddenTagsCount);
+            Writer.AddTags(Row->GrantedTags, Record.GrantedTagsStart, Record.GrantedTagsCount);
+
+            // Sort the extra magnitudes by name so the blob is byte-identical for identical tables
+            TArray<FName> MagnitudeNames;
+            Row->AdditionalMagnitudes.GetKeys(MagnitudeNames);
+            MagnitudeNames.Sort(FNameLexicalLess());
+
+            Record.MagnitudesStart = Writer.Magnitudes.Num();
+            Record.MagnitudesCount = MagnitudeNames.Num();
+
+            for (FName MagnitudeName : MagnitudeNames)
+            {
+                const FEffectScalingInfo& Scaling = Row->AdditionalMagnitudes[MagnitudeName];
+
+                FCombatMagnitudeRecord Magnitude;
+                FMemory::Memzero(Magnitude);
+
+                Magnitude.Name = Writer.AddName(MagnitudeName);
+                Magnitude.MagnitudeType = static_cast<uint8>(Scaling.MagnitudeType);
+                Magnitude.BaseValue = Scaling.BaseValue;
+                Magnitude.ScalingCoefficient = Scaling.ScalingCoefficient;
+                Magnitude.StatTag = Writer.AddName(Scaling.StatTag.GetTagName());
+                Magnitude.CustomFormula = Writer.AddName(Scaling.CustomFormula);
+
+                Writer.Magnitudes.Add(Magnitude);
+            }
+
+            Writer.Effects.Add(Record);
+        }
+    }
+
+    // Lay out header + sections from whatever the writer holds
+    void LayOutFileImage(const FCombatDatabaseWriter& Writer, uint32 AbilitySourceChecksum, uint32 EffectSourceChecksum, TArray<uint8>& OutBytes)
+    {
+        FCombatDatabaseHeader FileHeader;
+        FMemory::Memzero(FileHeader);
+        FileHeader.Magic = CombatDatabase::Magic;
+        FileHeader.FormatVersion = CombatDatabase::FormatVersion;
+        FileHeader.AbilitySourceChecksum = AbilitySourceChecksum;
+        FileHeader.EffectSourceChecksum = EffectSourceChecksum;
+
+        OutBytes.Reset();
+        OutBytes.AddZeroed(sizeof(FCombatDatabaseHeader));
+        const int32 PayloadStart = OutBytes.Num();
+
+        AppendSection(OutBytes, PayloadStart, Writer.Abilities, FileHeader.AbilityOffset, FileHeader.AbilityCount);
+        AppendSection(OutBytes, PayloadStart, Writer.Effects, FileHeader.EffectOffset, FileHeader.EffectCount);
+        AppendSection(OutBytes, PayloadStart, Writer.Magnitudes, FileHeader.MagnitudeOffset, FileHeader.MagnitudeCount);
+        AppendSection(OutBytes, PayloadStart, Writer.IndexPool, FileHeader.IndexOffset, FileHeader.IndexCount);
+        AppendSection(OutBytes, PayloadStart, Writer.Strings, FileHeader.StringOffset, FileHeader.StringSize);
+
+        FileHeader.PayloadSize = OutBytes.Num() - PayloadStart;
+        FileHeader.PayloadChecksum = FCrc::MemCrc32(OutBytes.GetData() + PayloadStart, FileHeader.PayloadSize);
+
+        FMemory::Memcpy(OutBytes.GetData(), &FileHeader, sizeof(FCombatDatabaseHeader));
+    }
+
+    // Checksum of the payload a writer holding one table lays out to
+    uint32 ComputeWriterChecksum(const FCombatDatabaseWriter& Writer)
+    {
+        TArray<uint8> Bytes;
+        LayOutFileImage(Writer, 0, 0, Bytes);
+
+        // Never 0, which stands for "no table"
+        const uint32 Checksum = reinterpret_cast<const FCombatDatabaseHeader*>(Bytes.GetData())->PayloadChecksum;
+        return Checksum != 0 ? Checksum : 1;
+    }
+}
+
+FCombatDatabase::FCombatDatabase()
+{
+}
+
+FCombatDatabase::~FCombatDatabase()
+{
+    Unmount();
+}
+
+bool FCombatDatabase::Mount(const FString& FilePath)
+{
+    Unmount();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.FileExists(*FilePath))
+    {
+        return false;
+    }
+
+    const uint8* Data = nullptr;
+    int64 Size = 0;
+
+    // Prefer mapping so the server pages in only the records it touches
+    MappedFile.Reset(PlatformFile.OpenMapped(*FilePath));
+    if (MappedFile)
+    {
+        MappedRegion.Reset(MappedFile->MapRegion());
+    }
+
+    if (MappedRegion)
+    {
+        Data = MappedRegion->GetMappedPtr();
+        Size = MappedRegion->GetMappedSize();
+    }
+    else
+    {
+        MappedFile.Reset();
+
+        if (!FFileHelper::LoadFileToArray(OwnedBytes, *FilePath))
+        {
+            return false;
+        }
+
+        Data = OwnedBytes.GetData();
+        Size = OwnedBytes.Num();
+    }
+
+    if (!Validate(Data, Size))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Combat database %s is invalid or out of date, ignoring it"), *FilePath);
+        Unmount();
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Mounted combat database %s (%d abilities, %d effects)"),
+        *FilePath, Header->AbilityCount, Header->EffectCount);
+    return true;
+}
+
+void FCombatDatabase::Unmount()
+{
+    Header = nullptr;
+    Payload = nullptr;
+
+    // Regions must go before the handle that owns them
+    MappedRegion.Reset();
+    MappedFile.Reset();
+    OwnedBytes.Empty();
+}
+
+bool FCombatDatabase::Validate(const uint8* Data, int64 Size)
+{
+    if (!Data || Size < (int64)sizeof(FCombatDatabaseHeader))
+    {
+        return false;
+    }
+
+    const FCombatDatabaseHeader* FileHeader = reinterpret_cast<const FCombatDatabaseHeader*>(Data);
+    if (FileHeader->Magic != CombatDatabase::Magic || FileHeader->FormatVersion != CombatDatabase::FormatVersion)
+    {
+        return false;
+    }
+
+    if ((int64)FileHeader->PayloadSize != Size - (int64)sizeof(FCombatDatabaseHeader))
+    {
+        return false;
+    }
+
+    const uint8* FilePayload = Data + sizeof(FCombatDatabaseHeader);
+    if (FCrc::MemCrc32(FilePayload, FileHeader->PayloadSize) != FileHeader->PayloadChecksum)
+    {
+        return false;
+    }
+
+    auto SectionFits = [FileHeader](uint32 Offset, uint32 Count, uint32 Stride)
+    {
+        return Offset % 4 == 0 && (uint64)Offset + (uint64)Count * Stride <= FileHeader->PayloadSize;
+    };
+
+    if (!SectionFits(FileHeader->AbilityOffset, FileHeader->AbilityCount, sizeof(FCombatAbilityRecord))
+        || !SectionFits(FileHeader->EffectOffset, FileHeader->EffectCount, sizeof(FCombatEffectRecord))
+        || !SectionFits(FileHeader->MagnitudeOffset, FileHeader->MagnitudeCount, sizeof(FCombatMagnitudeRecord))
+        || !SectionFits(FileHeader->IndexOffset, FileHeader->IndexCount, sizeof(uint32))
+        || (uint64)FileHeader->StringOffset + FileHeader->StringSize > FileHeader->PayloadSize)
+    {
+        return false;
+    }
+
+    if (FileHeader->StringSize > 0 && FilePayload[FileHeader->StringOffset + FileHeader->StringSize - 1] != 0)
+    {
+        return false;
+    }
+
+    Header = FileHeader;
+    Payload = FilePayload;
+
+    // Check every record once here so lookups can trust the offsets
+    auto StringValid = [FileHeader](uint32 Offset)
+    {
+        return Offset == CombatDatabase::NoString || Offset < FileHeader->StringSize;
+    };
+
+    auto IndexRangeValid = [FileHeader](uint32 Start, uint32 Count)
+    {
+        return (uint64)Start + Count <= FileHeader->IndexCount;
+    };
+
+    bool bRecordsValid = true;
+
+    // IDs must be strictly ascending for the binary search
+    int32 PreviousID = MIN_int32;
+    bool bFirstRecord = true;
+    for (const FCombatAbilityRecord& Ability : GetAbilities())
+    {
+        bRecordsValid &= bFirstRecord || Ability.AbilityID > PreviousID;
+        bRecordsValid &= StringValid(Ability.CooldownTag) && StringValid(Ability.AbilityClassPath);
+        bRecordsValid &= IndexRangeValid(Ability.AbilityTagsStart, Ability.AbilityTagsCount);
+        bRecordsValid &= IndexRangeValid(Ability.SelfEffectsStart, Ability.SelfEffectsCount);
+        bRecordsValid &= IndexRangeValid(Ability.TargetEffectsStart, Ability.TargetEffectsCount);
+        bRecordsValid &= IndexRangeValid(Ability.AreaEffectsStart, Ability.AreaEffectsCount);
+        PreviousID = Ability.AbilityID;
+        bFirstRecord = false;
+    }
+
+    bFirstRecord = true;
+    for (const FCombatEffectRecord& Effect : GetEffects())
+    {
+        bRecordsValid &= bFirstRecord || Effect.EffectID > PreviousID;
+        bRecordsValid &= StringValid(Effect.StatTag) && StringValid(Effect.CustomFormula);
+        bRecordsValid &= StringValid(Effect.AffectedAttributeTag) && StringValid(Effect.GameplayEffectClassPath);
+        bRecordsValid &= IndexRangeValid(Effect.RequiredTagsStart, Effect.RequiredTagsCount);
+        bRecordsValid &= IndexRangeValid(Effect.ForbiddenTagsStart, Effect.ForbiddenTagsCount);
+        bRecordsValid &= IndexRangeValid(Effect.GrantedTagsStart, Effect.GrantedTagsCount);
+        bRecordsValid &= (uint64)Effect.MagnitudesStart + Effect.MagnitudesCount <= FileHeader->MagnitudeCount;
+        PreviousID = Effect.EffectID;
+        bFirstRecord = false;
+    }
+
+    for (const FCombatMagnitudeRecord& Magnitude : GetMagnitudes(0, FileHeader->MagnitudeCount))
+    {
+        bRecordsValid &= StringValid(Magnitude.Name) && StringValid(Magnitude.StatTag) && StringValid(Magnitude.CustomFormula);
+    }
+
+    if (!bRecordsValid)
+    {
+        Header = nullptr;
+        Payload = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+bool FCombatDatabase::IsCurrentFor(const UAbilityDataAsset* AbilityData) const
+{
+    return Header && AbilityData && Header->AbilitySourceChecksum != 0 && AbilityData->GetSourceChecksum() == Header->AbilitySourceChecksum;
+}
+
+bool FCombatDatabase::IsCurrentFor(const UEffectDataAsset* EffectData) const
+{
+    return Header && EffectData && Header->EffectSourceChecksum != 0 && EffectData->GetSourceChecksum() == Header->EffectSourceChecksum;
+}
+
+TArrayView<const FCombatAbilityRecord> FCombatDatabase::GetAbilities() const
+{
+    if (!Header)
+    {
+        return TArrayView<const FCombatAbilityRecord>();
+    }
+
+    return TArrayView<const FCombatAbilityRecord>(reinterpret_cast<const FCombatAbilityRecord*>(Payload + Header->AbilityOffset), Header->AbilityCount);
+}
+
+TArrayView<const FCombatEffectRecord> FCombatDatabase::GetEffects() const
+{
+    if (!Header)
+    {
+        return TArrayView<const FCombatEffectRecord>();
+    }
+
+    return TArrayView<const FCombatEffectRecord>(reinterpret_cast<const FCombatEffectRecord*>(Payload + Header->EffectOffset), Header->EffectCount);
+}
+
+TArrayView<const FCombatMagnitudeRecord> FCombatDatabase::GetMagnitudes(uint32 Start, uint32 Count) const
+{
+    if (!Header || (uint64)Start + Count > Header->MagnitudeCount)
+    {
+        return TArrayView<const FCombatMagnitudeRecord>();
+    }
+
+    return TArrayView<const FCombatMagnitudeRecord>(reinterpret_cast<const FCombatMagnitudeRecord*>(Payload + Header->MagnitudeOffset) + Start, Count);
+}
+
+TArrayView<const uint32> FCombatDatabase::GetIndexRange(uint32 Start, uint32 Count) const
+{
+    if (!Header || (uint64)Start + Count > Header->IndexCount)
+    {
+        return TArrayView<const uint32>();
+    }
+
+    return TArrayView<const uint32>(reinterpret_cast<const uint32*>(Payload + Header->IndexOffset) + Start, Count);
+}
+
+const FCombatAbilityRecord* FCombatDatabase::FindAbility(int32 AbilityID) const
+{
+    TArrayView<const FCombatAbilityRecord> Abilities = GetAbilities();
+    const int32 Index = Algo::BinarySearchBy(Abilities, AbilityID, &FCombatAbilityRecord::AbilityID);
+    return Index != INDEX_NONE ? &Abilities[Index] : nullptr;
+}
+
+const FCombatEffectRecord* FCombatDatabase::FindEffect(int32 EffectID) const
+{
+    TArrayView<const FCombatEffectRecord> Effects = GetEffects();
+    const int32 Index = Algo::BinarySearchBy(Effects, EffectID, &FCombatEffectRecord::EffectID);
+    return Index != INDEX_NONE ? &Effects[Index] : nullptr;
+}
+
+const UTF8CHAR* FCombatDatabase::GetString(uint32 Offset) const
+{
+    if (!Header || Offset == CombatDatabase::NoString || Offset >= Header->StringSize)
+    {
+        return nullptr;
+    }
+
+    return reinterpret_cast<const UTF8CHAR*>(Payload + Header->StringOffset + Offset);
+}
+
+FName FCombatDatabase::GetName(uint32 Offset) const
+{
+    const UTF8CHAR* String = GetString(Offset);
+    if (!String)
+    {
+        return NAME_None;
+    }
+
+    FUTF8ToTCHAR Converted(String);
+    return FName(Converted.Length(), Converted.Get());
+}
+
+bool FCombatDatabase::BuildFileImage(const UAbilityDataAsset* AbilityData, const UEffectDataAsset* EffectData, TArray<uint8>& OutBytes)
+{
+    OutBytes.Reset();
+
+    if (!AbilityData || !AbilityData->AbilityDataTable || !EffectData || !EffectData->EffectsDataTable)
+    {
+        return false;
+    }
+
+    FCombatDatabaseWriter Writer;
+    WriteAbilities(Writer, *AbilityData);
+    WriteEffects(Writer, *EffectData);
+
+    LayOutFileImage(Writer, ComputeSourceChecksum(AbilityData), ComputeSourceChecksum(EffectData), OutBytes);
+    return true;
+}
+
+bool FCombatDatabase::WriteToFile(const UAbilityDataAsset* AbilityData, const UEffectDataAsset* EffectData, const FString& FilePath)
+{
+    TArray<uint8> Bytes;
+    if (!BuildFileImage(AbilityData, EffectData, Bytes))
+    {
+        return false;
+    }
+
+    return FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+}
+
+uint32 FCombatDatabase::ComputeSourceChecksum(const UAbilityDataAsset* AbilityData)
+{
+    if (!AbilityData || !AbilityData->AbilityDataTable)
+    {
+        return 0;
+    }
+
+    FCombatDatabaseWriter Writer;
+    WriteAbilities(Writer, *AbilityData);
+    return ComputeWriterChecksum(Writer);
+}
+
+uint32 FCombatDatabase::ComputeSourceChecksum(const UEffectDataAsset* EffectData)
+{
+    if (!EffectData || !EffectData->EffectsDataTable)
+    {
+        return 0;
+    }
+
+    FCombatDatabaseWriter Writer;
+    WriteEffects(Writer, *EffectData);
+    return ComputeWriterChecksum(Writer);
+}
+
+FString FCombatDatabase::GetDefaultPath()
+{
+    return FPaths::ProjectContentDir() / TEXT("CombatData/CombatDatabase.bin");
+}
@@ -0,0 +1,187 @@
+// File: CombatDatabase.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UAbilityDataAsset;
+class UEffectDataAsset;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+// Flat, versioned binary form of the ability and effect tables.
+// Every section is an array of fixed-size little-endian records sorted by ID, so a dedicated
+// server can map the file and look rows up in place without building UDataTable row maps.
+// Only gameplay fields are stored; descriptions, icons, VFX and sounds stay in the data assets.
+namespace CombatDatabase
+{
+    // "WCDB"
+    constexpr uint32 Magic = 0x42444357;
+
+    // Bump whenever a record layout below changes
+    constexpr uint32 FormatVersion = 2;
+
+    // String offset used for empty names and tags
+    constexpr uint32 NoString = MAX_uint32;
+}
+
+struct FCombatDatabaseHeader
+{
+    uint32 Magic;
+    uint32 FormatVersion;
+
+    // Size and CRC32 of everything after the header
+    uint32 PayloadSize;
+    uint32 PayloadChecksum;
+
+    // Source checksums of the tables the blob was built from, the same values the data assets stamp
+    // on themselves when they are saved or cooked
+    uint32 AbilitySourceChecksum;
+    uint32 EffectSourceChecksum;
+
+    // Section offsets are relative to the start of the payload
+    uint32 AbilityOffset;
+    uint32 AbilityCount;
+    uint32 EffectOffset;
+    uint32 EffectCount;
+    uint32 MagnitudeOffset;
+    uint32 MagnitudeCount;
+
+    // Pool of uint32 used for effect ID lists and tag lists (tags are string offsets)
+    uint32 IndexOffset;
+    uint32 IndexCount;
+
+    // UTF-8, null terminated strings
+    uint32 StringOffset;
+    uint32 StringSize;
+};
+
+struct FCombatAbilityRecord
+{
+    int32 AbilityID;
+    uint8 AbilityType;
+    uint8 bCanCastWhileMoving;
+    uint8 bUsesGlobalCooldown;
+    uint8 Padding;
+    float ManaCost;
+    float Cooldown;
+    float CastTime;
+    float MaxRange;
+    float AreaEffectRadius;
+    int32 DefaultHotbarSlot;
+    uint32 CooldownTag;
+    uint32 AbilityClassPath;
+    uint32 AbilityTagsStart;
+    uint32 AbilityTagsCount;
+    uint32 SelfEffectsStart;
+    uint32 SelfEffectsCount;
+    uint32 TargetEffectsStart;
+    uint32 TargetEffectsCount;
+    uint32 AreaEffectsStart;
+    uint32 AreaEffectsCount;
+};
+
+struct FCombatEffectRecord
+{
+    int32 EffectID;
+    uint8 EffectType;
+    uint8 DurationType;
+    uint8 MagnitudeType;
+    uint8 Padding;
+    float Duration;
+    float TickPeriod;
+    float BaseValue;
+    float ScalingCoefficient;
+    uint32 StatTag;
+    uint32 CustomFormula;
+    uint32 AffectedAttributeTag;
+    uint32 GameplayEffectClassPath;
+    uint32 RequiredTagsStart;
+    uint32 RequiredTagsCount;
+    uint32 ForbiddenTagsStart;
+    uint32 ForbiddenTagsCount;
+    uint32 GrantedTagsStart;
+    uint32 GrantedTagsCount;
+    uint32 MagnitudesStart;
+    uint32 MagnitudesCount;
+};
+
+// One entry of FEffectTableRow::AdditionalMagnitudes
+struct FCombatMagnitudeRecord
+{
+    uint32 Name;
+    uint8 MagnitudeType;
+    uint8 Padding[3];
+    float BaseValue;
+    float ScalingCoefficient;
+    uint32 StatTag;
+    uint32 CustomFormula;
+};
+
+static_assert(sizeof(FCombatDatabaseHeader) % 4 == 0, "Combat database header must stay 4-byte aligned");
+static_assert(sizeof(FCombatAbilityRecord) % 4 == 0, "Combat database records must stay 4-byte aligned");
+static_assert(sizeof(FCombatEffectRecord) % 4 == 0, "Combat database records must stay 4-byte aligned");
+static_assert(sizeof(FCombatMagnitudeRecord) % 4 == 0, "Combat database records must stay 4-byte aligned");
+
+// Read-only view over a mounted combat database file
+class MYPROJECT5_API FCombatDatabase
+{
+public:
+    FCombatDatabase();
+    ~FCombatDatabase();
+
+    // Map the file (or read it if the platform cannot map) and validate it. Returns false if missing or invalid
+    bool Mount(const FString& FilePath);
+
+    void Unmount();
+
+    bool IsMounted() const { return Header != nullptr; }
+
+    // True if the blob was built from the table this asset was saved with. Compares stamps, never reserializes
+    bool IsCurrentFor(const UAbilityDataAsset* AbilityData) const;
+    bool IsCurrentFor(const UEffectDataAsset* EffectData) const;
+
+    // Binary search by ID, nullptr if not found
+    const FCombatAbilityRecord* FindAbility(int32 AbilityID) const;
+    const FCombatEffectRecord* FindEffect(int32 EffectID) const;
+
+    TArrayView<const FCombatAbilityRecord> GetAbilities() const;
+    TArrayView<const FCombatEffectRecord> GetEffects() const;
+    TArrayView<const FCombatMagnitudeRecord> GetMagnitudes(uint32 Start, uint32 Count) const;
+
+    // Range in the uint32 pool (effect IDs or tag string offsets)
+    TArrayView<const uint32> GetIndexRange(uint32 Start, uint32 Count) const;
+
+    // Null terminated UTF-8 string at an offset, or nullptr for NoString
+    const UTF8CHAR* GetString(uint32 Offset) const;
+
+    // Convenience for names and tag names
+    FName GetName(uint32 Offset) const;
+
+    // Serialize the gameplay fields of both tables into a complete file image
+    static bool BuildFileImage(const UAbilityDataAsset* AbilityData, const UEffectDataAsset* EffectData, TArray<uint8>& OutBytes);
+
+    // Build and save the file image
+    static bool WriteToFile(const UAbilityDataAsset* AbilityData, const UEffectDataAsset* EffectData, const FString& FilePath);
+
+    // Checksum of one table's gameplay fields, 0 if the asset has no table. Serializes the whole table, so it
+    // is only run when building the blob and when the data assets are saved
+    static uint32 ComputeSourceChecksum(const UAbilityDataAsset* AbilityData);
+    static uint32 ComputeSourceChecksum(const UEffectDataAsset* EffectData);
+
+    // Where the cook step writes the blob and the server looks for it
+    static FString GetDefaultPath();
+
+private:
+    // Check header, section bounds, checksum and every record's offsets
+    bool Validate(const uint8* Data, int64 Size);
+
+    // Mapping used on platforms that support it
+    TUniquePtr<IMappedFileHandle> MappedFile;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+
+    // Fallback copy when the file cannot be mapped
+    TArray<uint8> OwnedBytes;
+
+    const FCombatDatabaseHeader* Header = nullptr;
+    const uint8* Payload = nullptr;
+};
@@ -0,0 +1,99 @@
+// File: CombatDatabaseSubsystem.cpp
+#include "CombatDatabaseSubsystem.h"
+#include "AbilityDataAsset.h"
+#include "EffectDataAsset.h"
+#include "Misc/CommandLine.h"
+
+void UCombatDatabaseSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    
+    // Only servers benefit from skipping table work; -CombatDatabase forces it on for testing
+    if (IsRunningDedicatedServer() || FParse::Param(FCommandLine::Get(), TEXT("CombatDatabase")))
+    {
+        if (!Database.Mount(FCombatDatabase::GetDefaultPath()))
+        {
+            UE_LOG(LogTemp, Log, TEXT("No usable combat database, using data assets"));
+        }
+    }
+}
+
+void UCombatDatabaseSubsystem::Deinitialize()
+{
+    Database.Unmount();
+    ReportedStaleSources.Empty();
+    
+    Super::Deinitialize();
+}
+
+const FCombatDatabase* UCombatDatabaseSubsystem::GetDatabase() const
+{
+    return Database.IsMounted() ? &Database : nullptr;
+}
+
+bool UCombatDatabaseSubsystem::ReportIfStale(const UObject* SourceAsset, bool bIsCurrent) const
+{
+    if (!bIsCurrent && SourceAsset && !ReportedStaleSources.Contains(SourceAsset))
+    {
+        ReportedStaleSources.Add(SourceAsset);
+        UE_LOG(LogTemp, Warning, TEXT("Combat database was not built from the table %s was cooked with, using the data asset for it"), 
+            *SourceAsset->GetName());
+    }
+    
+    return bIsCurrent;
+}
+
+const FCombatAbilityRecord* UCombatDatabaseSubsystem::FindAbility(const UAbilityDataAsset* AbilityData, int32 AbilityID) const
+{
+    if (!Database.IsMounted() || !ReportIfStale(AbilityData, Database.IsCurrentFor(AbilityData)))
+    {
+        return nullptr;
+    }
+    
+    return Database.FindAbility(AbilityID);
+}
+
+const FCombatEffectRecord* UCombatDatabaseSubsystem::FindEffect(const UEffectDataAsset* EffectData, int32 EffectID) const
+{
+    if (!Database.IsMounted() || !ReportIfStale(EffectData, Database.IsCurrentFor(EffectData)))
+    {
+        return nullptr;
+    }
+    
+    return Database.FindEffect(EffectID);
+}
+
+bool UCombatDatabaseSubsystem::GetAbilityEffectIDs(const UAbilityDataAsset* AbilityData, int32 AbilityID, EEffectContainerType ContainerType, TArray<int32>& OutEffectIDs) const
+{
+    OutEffectIDs.Reset();
+    
+    const FCombatAbilityRecord* AbilityRecord = FindAbility(AbilityData, AbilityID);
+    if (!AbilityRecord)
+    {
+        return false;
+    }
+    
+    TArrayView<const uint32> EffectIDs;
+    switch (ContainerType)
+    {
+        case EEffectContainerType::Self:
+            EffectIDs = Database.GetIndexRange(AbilityRecord->SelfEffectsStart, AbilityRecord->SelfEffectsCount);
+            break;
+            
+        case EEffectContainerType::Target:
+            EffectIDs = Database.GetIndexRange(AbilityRecord->TargetEffectsStart, AbilityRecord->TargetEffectsCount);
+            break;
+            
+        case EEffectContainerType::Area:
+            EffectIDs = Database.GetIndexRange(AbilityRecord->AreaEffectsStart, AbilityRecord->AreaEffectsCount);
+            break;
+    }
+    
+    OutEffectIDs.Reserve(EffectIDs.Num());
+    for (uint32 EffectID : EffectIDs)
+    {
+        OutEffectIDs.Add(static_cast<int32>(EffectID));
+    }
+    
+    return true;
+}
@@ -0,0 +1,45 @@
+// File: CombatDatabaseSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "CombatDatabase.h"
+#include "AbilityEffectTypes.h"
+#include "CombatDatabaseSubsystem.generated.h"
+
+class UAbilityDataAsset;
+class UEffectDataAsset;
+
+// Mounts the cooked combat database on dedicated servers and serves lookups straight from it.
+// Every lookup names the data asset it stands in for and only answers if the blob was built from the
+// table that asset was cooked with, so a stale asset falls back on its own without affecting the others.
+// Callers fall back to UAbilityDataAsset / UEffectDataAsset whenever this returns nullptr.
+UCLASS()
+class MYPROJECT5_API UCombatDatabaseSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+    
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    
+    // The mounted database, or nullptr if it is missing, invalid or stale
+    const FCombatDatabase* GetDatabase() const;
+    
+    // Lookups against the mapped blob, nullptr if unavailable, built from a different table than the
+    // asset's, or not found
+    const FCombatAbilityRecord* FindAbility(const UAbilityDataAsset* AbilityData, int32 AbilityID) const;
+    const FCombatEffectRecord* FindEffect(const UEffectDataAsset* EffectData, int32 EffectID) const;
+    
+    // Effect IDs of one of an ability's containers, read from the blob. False if FindAbility would fail
+    bool GetAbilityEffectIDs(const UAbilityDataAsset* AbilityData, int32 AbilityID, EEffectContainerType ContainerType, TArray<int32>& OutEffectIDs) const;
+    
+protected:
+    // Pass bIsCurrent through, warning the first time an asset does not match the blob
+    bool ReportIfStale(const UObject* SourceAsset, bool bIsCurrent) const;
+    
+    FCombatDatabase Database;
+    
+    // Assets already reported as not matching the blob
+    mutable TArray<TWeakObjectPtr<const UObject>> ReportedStaleSources;
+};
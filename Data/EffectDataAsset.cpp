@@ -1,22 +1,674 @@
 // File: EffectDataAsset.cpp
 #include "EffectDataAsset.h"
+#include "EffectFormula.h"
+#include "ScalingCurveDataAsset.h"
+#include "../Attributes/WoWAttributeSet.h"
+#include "CombatDatabase.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "UObject/PropertyPortFlags.h"
+#include "UObject/ObjectSaveContext.h"
+#include "Misc/ScopeRWLock.h"
+#include "AbilitySystemComponent.h"
+#include "../WoWGameplayTags.h"
 
-bool UEffectDataAsset::GetEffectDataByID(int32 EffectID, FEffectTableRow& OutEffectData) const
+namespace
+{
+    // Bundle holding everything the simulation needs
+    const FName GameplayBundleName(TEXT("Gameplay"));
+    
+    // Bundle holding presentation-only assets
+    const FName ClientBundleName(TEXT("Client"));
+}
+
+namespace
+{
+    // Backing store for FEffectMagnitudeNames. Written while tables compile, read from any thread
+    struct FMagnitudeNameTable
+    {
+        FRWLock Lock;
+        TMap<FName, int32> Indices;
+        TArray<FName> Names;
+    };
+    
+    FMagnitudeNameTable& GetMagnitudeNameTable()
+    {
+        static FMagnitudeNameTable Table;
+        return Table;
+    }
+}
+
+int32 FEffectMagnitudeNames::Intern(FName Name)
+{
+    FMagnitudeNameTable& Table = GetMagnitudeNameTable();
+    
+    {
+        FReadScopeLock ReadLock(Table.Lock);
+        if (const int32* Existing = Table.Indices.Find(Name))
+        {
+            return *Existing;
+        }
+    }
+    
+    FWriteScopeLock WriteLock(Table.Lock);
+    if (const int32* Existing = Table.Indices.Find(Name))
+    {
+        return *Existing;
+    }
+    
+    const int32 NameIndex = Table.Names.Add(Name);
+    Table.Indices.Add(Name, NameIndex);
+    return NameIndex;
+}
+
+int32 FEffectMagnitudeNames::Find(FName Name)
+{
+    FMagnitudeNameTable& Table = GetMagnitudeNameTable();
+    
+    FReadScopeLock ReadLock(Table.Lock);
+    const int32* Existing = Table.Indices.Find(Name);
+    return Existing ? *Existing : INDEX_NONE;
+}
+
+FName FEffectMagnitudeNames::GetName(int32 NameIndex)
+{
+    FMagnitudeNameTable& Table = GetMagnitudeNameTable();
+    
+    FReadScopeLock ReadLock(Table.Lock);
+    return Table.Names.IsValidIndex(NameIndex) ? Table.Names[NameIndex] : NAME_None;
+}
+
+void FCompiledTagRequirements::Compile(const FGameplayTagContainer& Required, const FGameplayTagContainer& Forbidden)
+{
+    RequiredTags.Reset();
+    ForbiddenTags.Reset();
+    
+    for (const FGameplayTag& Tag : Required)
+    {
+        // Owning "State.Rooted.Frozen" already counts as owning "State.Rooted", drop the parent
+        bool bImplied = false;
+        for (const FGameplayTag& Other : Required)
+        {
+            if (Other != Tag && Other.MatchesTag(Tag))
+            {
+                bImplied = true;
+                break;
+            }
+        }
+        
+        if (!bImplied)
+        {
+            RequiredTags.Add(Tag);
+        }
+    }
+    
+    for (const FGameplayTag& Tag : Forbidden)
+    {
+        // A forbidden parent already rejects every child
+        bool bCovered = false;
+        for (const FGameplayTag& Other : Forbidden)
+        {
+            if (Other != Tag && Tag.MatchesTag(Other))
+            {
+                bCovered = true;
+                break;
+            }
+        }
+        
+        if (!bCovered)
+        {
+            ForbiddenTags.Add(Tag);
+        }
+    }
+}
+
+bool FCompiledTagRequirements::HasRequiredTags(const UAbilitySystemComponent& TargetASC) const
+{
+    // The count map holds every owned tag and its parents, one lookup per tag
+    for (const FGameplayTag& Tag : RequiredTags)
+    {
+        if (!TargetASC.HasMatchingGameplayTag(Tag))
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool FCompiledTagRequirements::HasForbiddenTags(const UAbilitySystemComponent& TargetASC) const
 {
+    for (const FGameplayTag& Tag : ForbiddenTags)
+    {
+        if (TargetASC.HasMatchingGameplayTag(Tag))
+        {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+int32 FCompiledTagRequirements::FilterTargets(TArrayView<const UAbilitySystemComponent* const> TargetASCs, TArray<int32>& OutPassingIndices) const
+{
+    const int32 NumBefore = OutPassingIndices.Num();
+    OutPassingIndices.Reserve(NumBefore + TargetASCs.Num());
+    
+    const bool bCheckTags = !IsEmpty();
+    
+    for (int32 TargetIndex = 0; TargetIndex < TargetASCs.Num(); ++TargetIndex)
+    {
+        const UAbilitySystemComponent* TargetASC = TargetASCs[TargetIndex];
+        if (TargetASC && (!bCheckTags || Matches(*TargetASC)))
+        {
+            OutPassingIndices.Add(TargetIndex);
+        }
+    }
+    
+    return OutPassingIndices.Num() - NumBefore;
+}
+
+const FCompiledEffectRecord* FEffectDataSnapshot::FindRecord(int32 EffectID) const
+{
+    const int32* RecordIndex = IDIndex.Find(EffectID);
+    return RecordIndex ? &Records[*RecordIndex] : nullptr;
+}
+
+const FPrimaryAssetType UEffectDataAsset::PrimaryAssetType(TEXT("EffectData"));
+
+FPrimaryAssetId UEffectDataAsset::GetPrimaryAssetId() const
+{
+    return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
+
+void UEffectDataAsset::PostLoad()
+{
+    Super::PostLoad();
+    
+    RebuildIndex();
+}
+
+void UEffectDataAsset::BeginDestroy()
+{
+    UnbindDataTable();
+    UnbindScalingCurves();
+    
+    Super::BeginDestroy();
+}
+
+#if WITH_EDITOR
+void UEffectDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    
+    if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UEffectDataAsset, EffectsDataTable))
+    {
+        RebuildIndex();
+    }
+    else if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UEffectDataAsset, CustomFormulas))
+    {
+        // Formulas live outside the rows, so unchanged rows cannot be reused
+        RebuildIndex(true);
+    }
+    else if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UEffectDataAsset, ScalingCurves))
+    {
+        RebuildIndex();
+    }
+}
+
+void UEffectDataAsset::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+    Super::PreSave(ObjectSaveContext);
+    
+    SourceChecksum = FCombatDatabase::ComputeSourceChecksum(this);
+}
+#endif
+
+#if WITH_EDITORONLY_DATA
+void UEffectDataAsset::UpdateAssetBundleData()
+{
+    Super::UpdateAssetBundleData();
+    
     if (!EffectsDataTable)
     {
-        return false;
+        return;
     }
     
-    // Search for the effect with matching ID
     TArray<FEffectTableRow*> AllEffects;
-    EffectsDataTable->GetAllRows<FEffectTableRow>(TEXT("GetEffectDataByID"), AllEffects);
+    EffectsDataTable->GetAllRows<FEffectTableRow>(TEXT("UpdateAssetBundleData"), AllEffects);
+    
+    auto AddToBundle = [this](FName BundleName, const FSoftObjectPath& Path)
+    {
+        if (!Path.IsNull())
+        {
+            AssetBundleData.AddBundleAsset(BundleName, Path.GetAssetPath());
+        }
+    };
+    
+    for (const FEffectTableRow* EffectRow : AllEffects)
+    {
+        if (!EffectRow)
+        {
+            continue;
+        }
+        
+        AddToBundle(GameplayBundleName, EffectRow->GameplayEffectClass.ToSoftObjectPath());
+        AddToBundle(ClientBundleName, EffectRow->ApplicationVFX.ToSoftObjectPath());
+        AddToBundle(ClientBundleName, EffectRow->PersistentVFX.ToSoftObjectPath());
+        AddToBundle(ClientBundleName, EffectRow->ApplicationSound.ToSoftObjectPath());
+        AddToBundle(ClientBundleName, EffectRow->PersistentSound.ToSoftObjectPath());
+    }
+}
+#endif
+
+void UEffectDataAsset::UnbindDataTable()
+{
+    if (UDataTable* OldTable = IndexedDataTable.Get())
+    {
+        OldTable->OnDataTableChanged().Remove(DataTableChangedHandle);
+    }
+    
+    DataTableChangedHandle.Reset();
+    IndexedDataTable.Reset();
+}
+
+void UEffectDataAsset::UnbindScalingCurves()
+{
+    if (UScalingCurveDataAsset* OldCurves = BoundScalingCurves.Get())
+    {
+        OldCurves->OnCurvesBaked.Remove(ScalingCurvesBakedHandle);
+    }
+    
+    ScalingCurvesBakedHandle.Reset();
+    BoundScalingCurves.Reset();
+}
+
+void UEffectDataAsset::OnScalingCurvesBaked()
+{
+    RebuildIndex(true);
+}
+
+void UEffectDataAsset::RebuildIndex(bool bRecompileAll)
+{
+    // Re-bind if the table itself was swapped
+    if (IndexedDataTable.Get() != EffectsDataTable)
+    {
+        UnbindDataTable();
+        
+        if (EffectsDataTable)
+        {
+            DataTableChangedHandle = EffectsDataTable->OnDataTableChanged().AddUObject(this, &UEffectDataAsset::OnEffectsDataTableChanged);
+            IndexedDataTable = EffectsDataTable;
+        }
+    }
+    
+    // Records hold tables baked by the scaling asset, a different asset means none can be reused
+    if (BoundScalingCurves.Get() != ScalingCurves)
+    {
+        UnbindScalingCurves();
+        bRecompileAll = true;
+        
+        if (ScalingCurves)
+        {
+            ScalingCurvesBakedHandle = ScalingCurves->OnCurvesBaked.AddUObject(this, &UEffectDataAsset::OnScalingCurvesBaked);
+            BoundScalingCurves = ScalingCurves;
+        }
+    }
+    
+    const FEffectDataSnapshot* PreviousSnapshot = CurrentSnapshot.Get();
+    
+    TSharedRef<FEffectDataSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FEffectDataSnapshot, ESPMode::ThreadSafe>();
+    NewSnapshot->Version = PreviousSnapshot ? PreviousSnapshot->Version + 1 : 1;
+    
+    int32 NumChangedRows = 0;
+    
+    if (EffectsDataTable)
+    {
+        TArray<FEffectTableRow*> AllEffects;
+        EffectsDataTable->GetAllRows<FEffectTableRow>(TEXT("RebuildIndex"), AllEffects);
+        
+        NewSnapshot->Records.Reserve(AllEffects.Num());
+        NewSnapshot->Rows.Reserve(AllEffects.Num());
+        NewSnapshot->IDIndex.Reserve(AllEffects.Num());
+        
+        const UScriptStruct* RowStruct = FEffectTableRow::StaticStruct();
+        
+        for (const FEffectTableRow* EffectRow : AllEffects)
+        {
+            if (!EffectRow)
+            {
+                continue;
+            }
+            
+            if (NewSnapshot->IDIndex.Contains(EffectRow->EffectID))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("%s: duplicate effect ID %d (%s) ignored"), 
+                    *GetName(), EffectRow->EffectID, *EffectRow->EffectName);
+                continue;
+            }
+            
+            const int32 RecordIndex = NewSnapshot->Records.AddDefaulted();
+            NewSnapshot->IDIndex.Add(EffectRow->EffectID, RecordIndex);
+            
+            // An unchanged row keeps its shared copy and compiled record, including the resolved class
+            const int32* PreviousIndex = PreviousSnapshot && !bRecompileAll ? PreviousSnapshot->IDIndex.Find(EffectRow->EffectID) : nullptr;
+            if (PreviousIndex && RowStruct->CompareScriptStruct(PreviousSnapshot->Rows[*PreviousIndex].Get(), EffectRow, PPF_None))
+            {
+                NewSnapshot->Rows.Add(PreviousSnapshot->Rows[*PreviousIndex]);
+                NewSnapshot->Records[RecordIndex] = PreviousSnapshot->Records[*PreviousIndex];
+                continue;
+            }
+            
+            FEffectRowPtr SharedRow = MakeShared<FEffectTableRow, ESPMode::ThreadSafe>(*EffectRow);
+            NewSnapshot->Rows.Add(SharedRow);
+            CompileEffectRecord(*SharedRow, NewSnapshot->Records[RecordIndex]);
+            ++NumChangedRows;
+        }
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("%s: effect snapshot %u built, %d of %d rows recompiled"), 
+        *GetName(), NewSnapshot->Version, NumChangedRows, NewSnapshot->Records.Num());
+    
+    SwapSnapshot(NewSnapshot);
+}
+
+void UEffectDataAsset::PatchEffectRows(const TArray<FEffectTableRow>& ChangedRows)
+{
+    EnsureIndexBuilt();
+    
+    if (ChangedRows.Num() == 0 || !CurrentSnapshot.IsValid())
+    {
+        return;
+    }
+    
+    // Records are small PODs and rows are shared, so copying the snapshot is cheap next to recompiling it
+    TSharedRef<FEffectDataSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FEffectDataSnapshot, ESPMode::ThreadSafe>(*CurrentSnapshot);
+    NewSnapshot->Version = CurrentSnapshot->Version + 1;
+    
+    for (const FEffectTableRow& ChangedRow : ChangedRows)
+    {
+        FEffectRowPtr SharedRow = MakeShared<FEffectTableRow, ESPMode::ThreadSafe>(ChangedRow);
+        
+        int32 RecordIndex = INDEX_NONE;
+        if (const int32* ExistingIndex = NewSnapshot->IDIndex.Find(ChangedRow.EffectID))
+        {
+            RecordIndex = *ExistingIndex;
+            NewSnapshot->Rows[RecordIndex] = SharedRow;
+            NewSnapshot->Records[RecordIndex] = FCompiledEffectRecord();
+        }
+        else
+        {
+            RecordIndex = NewSnapshot->Records.AddDefaulted();
+            NewSnapshot->Rows.Add(SharedRow);
+            NewSnapshot->IDIndex.Add(ChangedRow.EffectID, RecordIndex);
+        }
+        
+        CompileEffectRecord(*SharedRow, NewSnapshot->Records[RecordIndex]);
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("%s: patched %d effect rows into snapshot %u"), 
+        *GetName(), ChangedRows.Num(), NewSnapshot->Version);
+    
+    SwapSnapshot(NewSnapshot);
+}
+
+void UEffectDataAsset::SwapSnapshot(const TSharedRef<FEffectDataSnapshot, ESPMode::ThreadSafe>& NewSnapshot)
+{
+    CurrentSnapshot = NewSnapshot;
+    
+    // Rows added by a reimport or patch need streaming too
+    if (bPreloadRequested)
+    {
+        RequestAsyncPreload(bPreloadCosmetics);
+    }
+    
+    OnSnapshotChanged.Broadcast(CurrentSnapshot);
+}
+
+void UEffectDataAsset::CompileEffectRecord(const FEffectTableRow& EffectRow, FCompiledEffectRecord& OutRecord)
+{
+    OutRecord.EffectID = EffectRow.EffectID;
+    OutRecord.EffectType = EffectRow.EffectType;
+    OutRecord.Duration = EffectRow.Duration;
+    OutRecord.TickPeriod = EffectRow.TickPeriod;
+    OutRecord.SourceRow = &EffectRow;
+    
+    EEffectRecordFlags Flags = EEffectRecordFlags::None;
+    
+    if (EffectRow.DurationType == EEffectDurationType::Duration)
+    {
+        Flags |= EEffectRecordFlags::HasDuration;
+    }
+    else if (EffectRow.DurationType == EEffectDurationType::Permanent)
+    {
+        Flags |= EEffectRecordFlags::Permanent;
+    }
+    
+    if (EffectRow.TickPeriod > 0.0f)
+    {
+        Flags |= EEffectRecordFlags::Periodic;
+    }
+    
+    // Pick the SetByCaller channel once instead of per application
+    switch (EffectRow.EffectType)
+    {
+        case EEffectType::Damage:
+        case EEffectType::DamageOverTime:
+            Flags |= EEffectRecordFlags::Damage | EEffectRecordFlags::NegateMagnitude;
+            OutRecord.SetByCallerTag = WoWGameplayTags::Data_Damage;
+            break;
+            
+        case EEffectType::Healing:
+        case EEffectType::HealingOverTime:
+            Flags |= EEffectRecordFlags::Healing;
+            OutRecord.SetByCallerTag = WoWGameplayTags::Data_Healing;
+            break;
+            
+        default:
+            OutRecord.SetByCallerTag = WoWGameplayTags::Data_Magnitude;
+            break;
+    }
+    
+    OutRecord.TargetRequirements.Compile(EffectRow.RequiredTargetTags, EffectRow.ForbiddenTargetTags);
+    
+    if (OutRecord.TargetRequirements.RequiredTags.Num() > 0)
+    {
+        Flags |= EEffectRecordFlags::HasRequiredTags;
+    }
+    
+    if (OutRecord.TargetRequirements.ForbiddenTags.Num() > 0)
+    {
+        Flags |= EEffectRecordFlags::HasForbiddenTags;
+    }
+    
+    // Resolve attributes up front so the apply path never maps tags to attributes
+    OutRecord.AffectedAttribute = UWoWAttributeSet::GetAttributeForStatTag(EffectRow.AffectedAttributeTag);
+    
+    CompileMagnitude(EffectRow, EffectRow.Magnitude, OutRecord.Magnitude);
+    
+    if (OutRecord.Magnitude.StatAttribute.IsValid())
+    {
+        Flags |= EEffectRecordFlags::HasStatScaling;
+    }
+    
+    // Flatten the secondary magnitudes so the apply path never touches the row's map
+    OutRecord.AdditionalMagnitudes.Reset(EffectRow.AdditionalMagnitudes.Num());
+    for (const TPair<FName, FEffectScalingInfo>& Entry : EffectRow.AdditionalMagnitudes)
+    {
+        FCompiledEffectMagnitude& Compiled = OutRecord.AdditionalMagnitudes.AddDefaulted_GetRef();
+        Compiled.NameIndex = FEffectMagnitudeNames::Intern(Entry.Key);
+        CompileMagnitude(EffectRow, Entry.Value, Compiled);
+    }
+    
+    OutRecord.AdditionalMagnitudes.Sort([](const FCompiledEffectMagnitude& A, const FCompiledEffectMagnitude& B)
+    {
+        return A.NameIndex < B.NameIndex;
+    });
+    
+    OutRecord.Flags = Flags;
+    
+    ResolveRecordClass(OutRecord);
+}
+
+void UEffectDataAsset::CompileMagnitude(const FEffectTableRow& EffectRow, const FEffectScalingInfo& Scaling, FCompiledEffectMagnitude& OutMagnitude)
+{
+    OutMagnitude.MagnitudeType = Scaling.MagnitudeType;
+    OutMagnitude.BaseValue = Scaling.BaseValue;
+    OutMagnitude.ScalingCoefficient = Scaling.ScalingCoefficient;
+    
+    switch (Scaling.MagnitudeType)
+    {
+        case EEffectMagnitudeType::ScaledByStat:
+            OutMagnitude.StatAttribute = UWoWAttributeSet::GetAttributeForStatTag(Scaling.StatTag);
+            
+            if (!OutMagnitude.StatAttribute.IsValid())
+            {
+                UE_LOG(LogTemp, Warning, TEXT("%s: effect %d scales from unknown stat %s"), 
+                    *GetName(), EffectRow.EffectID, *Scaling.StatTag.ToString());
+            }
+            break;
+            
+        case EEffectMagnitudeType::ScaledByLevel:
+            if (!Scaling.LevelCurve.IsNone())
+            {
+                OutMagnitude.LevelCurve = ScalingCurves ? ScalingCurves->FindTable(Scaling.LevelCurve) : nullptr;
+                
+                if (!OutMagnitude.LevelCurve.IsValid())
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("%s: effect %d level curve %s not found, scaling linearly"), 
+                        *GetName(), EffectRow.EffectID, *Scaling.LevelCurve.ToString());
+                }
+            }
+            break;
+            
+        case EEffectMagnitudeType::Custom:
+            OutMagnitude.Formula = CompileFormula(EffectRow, Scaling);
+            break;
+            
+        default:
+            break;
+    }
+}
+
+TSharedPtr<const FEffectFormula, ESPMode::ThreadSafe> UEffectDataAsset::CompileFormula(const FEffectTableRow& EffectRow, const FEffectScalingInfo& Scaling) const
+{
+    if (Scaling.CustomFormula.IsNone())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s: effect %d uses a custom magnitude without a formula, using its base value"), 
+            *GetName(), EffectRow.EffectID);
+        return nullptr;
+    }
+    
+    const FString* NamedFormula = CustomFormulas.Find(Scaling.CustomFormula);
+    const FString FormulaSource = NamedFormula ? *NamedFormula : Scaling.CustomFormula.ToString();
     
-    for (FEffectTableRow* EffectRow : AllEffects)
+    TSharedRef<FEffectFormula, ESPMode::ThreadSafe> Formula = MakeShared<FEffectFormula, ESPMode::ThreadSafe>();
+    
+    FString Error;
+    if (!FEffectFormula::Compile(FormulaSource, Scaling, EffectRow.AdditionalMagnitudes, *Formula, Error))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%s: effect %d formula failed to compile, using its base value: %s"), 
+            *GetName(), EffectRow.EffectID, *Error);
+        return nullptr;
+    }
+    
+    return Formula;
+}
+
+bool UEffectDataAsset::ResolveRecordClass(FCompiledEffectRecord& Record)
+{
+    if (Record.GameplayEffectCDO)
+    {
+        return true;
+    }
+    
+    UClass* GEClass = Record.SourceRow ? Record.SourceRow->GameplayEffectClass.Get() : nullptr;
+    if (!GEClass)
     {
-        if (EffectRow && EffectRow->EffectID == EffectID)
+        return false;
+    }
+    
+    Record.GameplayEffectClass = GEClass;
+    Record.GameplayEffectCDO = GEClass->GetDefaultObject<UGameplayEffect>();
+    ResolvedEffectClasses.AddUnique(GEClass);
+    return Record.GameplayEffectCDO != nullptr;
+}
+
+void UEffectDataAsset::RequestAsyncPreload(bool bIncludeCosmetics)
+{
+    EnsureIndexBuilt();
+    
+    bPreloadRequested = true;
+    bPreloadCosmetics |= bIncludeCosmetics && !IsRunningDedicatedServer();
+    
+    // Collect everything that is not in memory yet
+    TArray<FSoftObjectPath> PathsToStream;
+    
+    auto AddIfUnloaded = [&PathsToStream](const FSoftObjectPath& Path, const UObject* LoadedObject)
+    {
+        if (!Path.IsNull() && !LoadedObject)
+        {
+            PathsToStream.AddUnique(Path);
+        }
+    };
+    
+    if (!CurrentSnapshot.IsValid())
+    {
+        return;
+    }
+    
+    for (const FCompiledEffectRecord& Record : CurrentSnapshot->Records)
+    {
+        if (Record.GameplayEffectCDO || !Record.SourceRow)
+        {
+            continue;
+        }
+        
+        AddIfUnloaded(Record.SourceRow->GameplayEffectClass.ToSoftObjectPath(), Record.SourceRow->GameplayEffectClass.Get());
+    }
+    
+    if (bPreloadCosmetics)
+    {
+        for (const FCompiledEffectRecord& Record : CurrentSnapshot->Records)
+        {
+            if (const FEffectTableRow* EffectRow = Record.SourceRow)
+            {
+                AddIfUnloaded(EffectRow->ApplicationVFX.ToSoftObjectPath(), EffectRow->ApplicationVFX.Get());
+                AddIfUnloaded(EffectRow->PersistentVFX.ToSoftObjectPath(), EffectRow->PersistentVFX.Get());
+                AddIfUnloaded(EffectRow->ApplicationSound.ToSoftObjectPath(), EffectRow->ApplicationSound.Get());
+                AddIfUnloaded(EffectRow->PersistentSound.ToSoftObjectPath(), EffectRow->PersistentSound.Get());
+            }
+        }
+    }
+    
+    // Everything is in memory already (e.g. loaded with the asset's bundles), only resolve it
+    if (PathsToStream.Num() == 0)
+    {
+        PublishResolvedClasses();
+        return;
+    }
+    
+    UE_LOG(LogTemp, Log, TEXT("%s: streaming %d effect assets"), *GetName(), PathsToStream.Num());
+    
+    PruneHandles();
+    
+    TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        PathsToStream, 
+        FStreamableDelegate::CreateUObject(this, &UEffectDataAsset::OnPreloadComplete),
+        FStreamableManager::AsyncLoadHighPriority);
+    
+    if (Handle.IsValid())
+    {
+        PreloadHandles.Add(Handle);
+    }
+}
+
+bool UEffectDataAsset::IsPreloading() const
+{
+    for (const TSharedPtr<FStreamableHandle>& Handle : PreloadHandles)
+    {
+        if (Handle.IsValid() && Handle->IsLoadingInProgress())
         {
-            OutEffectData = *EffectRow;
             return true;
         }
     }
@@ -24,38 +676,158 @@ bool UEffectDataAsset::GetEffectDataByID(int32 EffectID, FEffectTableRow& OutEff
     return false;
 }
 
-bool UEffectDataAsset::GetEffectsDataByIDs(const TArray<int32>& EffectIDs, TArray<FEffectTableRow>& OutEffectsData) const
+void UEffectDataAsset::OnPreloadComplete()
+{
+    PruneHandles();
+    
+    // Pick up the freshly loaded classes so the apply path stays on the resolved-pointer fast path
+    PublishResolvedClasses();
+}
+
+void UEffectDataAsset::PruneHandles()
 {
-    if (!EffectsDataTable || EffectIDs.Num() == 0)
+    for (int32 Index = PreloadHandles.Num() - 1; Index >= 0; --Index)
     {
-        return false;
+        const TSharedPtr<FStreamableHandle>& Handle = PreloadHandles[Index];
+        if (Handle.IsValid() && Handle->IsLoadingInProgress())
+        {
+            continue;
+        }
+        
+        if (Handle.IsValid() && Handle->HasLoadCompleted())
+        {
+            TArray<UObject*> LoadedAssets;
+            Handle->GetLoadedAssets(LoadedAssets);
+            
+            for (UObject* LoadedAsset : LoadedAssets)
+            {
+                if (LoadedAsset)
+                {
+                    PreloadedAssets.AddUnique(LoadedAsset);
+                }
+            }
+        }
+        
+        PreloadHandles.RemoveAtSwap(Index, 1, false);
+    }
+}
+
+void UEffectDataAsset::PublishResolvedClasses()
+{
+    if (!CurrentSnapshot.IsValid())
+    {
+        return;
     }
     
-    // Clear the output array
-    OutEffectsData.Empty();
+    // Readers may hold the current snapshot, so resolve into a copy and only publish it if anything changed
+    TSharedPtr<FEffectDataSnapshot, ESPMode::ThreadSafe> NewSnapshot;
     
-    // Get all effects in the table
-    TArray<FEffectTableRow*> AllEffects;
-    EffectsDataTable->GetAllRows<FEffectTableRow>(TEXT("GetEffectsDataByIDs"), AllEffects);
+    for (int32 RecordIndex = 0; RecordIndex < CurrentSnapshot->Records.Num(); ++RecordIndex)
+    {
+        const FCompiledEffectRecord& Record = CurrentSnapshot->Records[RecordIndex];
+        if (Record.GameplayEffectCDO || !Record.SourceRow || !Record.SourceRow->GameplayEffectClass.Get())
+        {
+            continue;
+        }
+        
+        if (!NewSnapshot.IsValid())
+        {
+            NewSnapshot = MakeShared<FEffectDataSnapshot, ESPMode::ThreadSafe>(*CurrentSnapshot);
+            NewSnapshot->Version = CurrentSnapshot->Version + 1;
+        }
+        
+        ResolveRecordClass(NewSnapshot->Records[RecordIndex]);
+    }
+    
+    if (NewSnapshot.IsValid())
+    {
+        SwapSnapshot(NewSnapshot.ToSharedRef());
+    }
+}
+
+const UGameplayEffect* UEffectDataAsset::TryResolveEffectClass(const FCompiledEffectRecord& Record)
+{
+    if (Record.GameplayEffectCDO)
+    {
+        return Record.GameplayEffectCDO;
+    }
+    
+    if (!Record.SourceRow)
+    {
+        return nullptr;
+    }
     
-    // Create a map for faster lookups
-    TMap<int32, FEffectTableRow*> EffectMap;
-    for (FEffectTableRow* EffectRow : AllEffects)
+    const TSoftClassPtr<UGameplayEffect>& EffectClass = Record.SourceRow->GameplayEffectClass;
+    if (UClass* LoadedClass = EffectClass.Get())
     {
-        if (EffectRow)
+        // Loaded by something else since the record was compiled
+        PublishResolvedClasses();
+        return LoadedClass->GetDefaultObject<UGameplayEffect>();
+    }
+    
+    // Not loaded and nothing in flight (preload was never requested), so start streaming it now
+    if (!IsPreloading() && !EffectClass.IsNull())
+    {
+        PruneHandles();
+        
+        TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+            EffectClass.ToSoftObjectPath(),
+            FStreamableDelegate::CreateUObject(this, &UEffectDataAsset::OnPreloadComplete),
+            FStreamableManager::AsyncLoadHighPriority);
+        
+        if (Handle.IsValid())
         {
-            EffectMap.Add(EffectRow->EffectID, EffectRow);
+            PreloadHandles.Add(Handle);
         }
     }
     
-    // Find each requested effect
+    return nullptr;
+}
+
+void UEffectDataAsset::OnEffectsDataTableChanged()
+{
+    RebuildIndex();
+}
+
+void UEffectDataAsset::EnsureIndexBuilt() const
+{
+    if (!CurrentSnapshot.IsValid() || IndexedDataTable.Get() != EffectsDataTable || BoundScalingCurves.Get() != ScalingCurves)
+    {
+        // The table was assigned at runtime, index it on first use
+        const_cast<UEffectDataAsset*>(this)->RebuildIndex();
+    }
+}
+
+const FEffectTableRow* UEffectDataAsset::FindEffectDataByID(int32 EffectID) const
+{
+    const FCompiledEffectRecord* Record = FindCompiledEffect(EffectID);
+    return Record ? Record->SourceRow : nullptr;
+}
+
+const FCompiledEffectRecord* UEffectDataAsset::FindCompiledEffect(int32 EffectID) const
+{
+    EnsureIndexBuilt();
+    
+    return CurrentSnapshot.IsValid() ? CurrentSnapshot->FindRecord(EffectID) : nullptr;
+}
+
+FEffectDataSnapshotPtr UEffectDataAsset::GetSnapshot() const
+{
+    EnsureIndexBuilt();
+    
+    return CurrentSnapshot;
+}
+
+bool UEffectDataAsset::FindEffectsDataByIDs(const TArray<int32>& EffectIDs, TArray<const FEffectTableRow*>& OutEffectsData) const
+{
+    OutEffectsData.Reset(EffectIDs.Num());
+    
     bool FoundAll = true;
     for (int32 ID : EffectIDs)
     {
-        FEffectTableRow* const* FoundEffect = EffectMap.Find(ID);
-        if (FoundEffect && *FoundEffect)
+        if (const FEffectTableRow* EffectRow = FindEffectDataByID(ID))
         {
-            OutEffectsData.Add(**FoundEffect);
+            OutEffectsData.Add(EffectRow);
         }
         else
         {
@@ -64,4 +836,38 @@ bool UEffectDataAsset::GetEffectsDataByIDs(const TArray<int32>& EffectIDs, TArra
     }
     
     return FoundAll && OutEffectsData.Num() > 0;
-}
\ No newline at end of file
+}
+
+bool UEffectDataAsset::GetEffectDataByID(int32 EffectID, FEffectTableRow& OutEffectData) const
+{
+    const FEffectTableRow* EffectRow = FindEffectDataByID(EffectID);
+    if (!EffectRow)
+    {
+        return false;
+    }
+    
+    OutEffectData = *EffectRow;
+    return true;
+}
+
+bool UEffectDataAsset::GetEffectsDataByIDs(const TArray<int32>& EffectIDs, TArray<FEffectTableRow>& OutEffectsData) const
+{
+    // Clear the output array
+    OutEffectsData.Empty();
+    
+    if (EffectIDs.Num() == 0)
+    {
+        return false;
+    }
+    
+    TArray<const FEffectTableRow*> FoundEffects;
+    bool FoundAll = FindEffectsDataByIDs(EffectIDs, FoundEffects);
+    
+    OutEffectsData.Reserve(FoundEffects.Num());
+    for (const FEffectTableRow* EffectRow : FoundEffects)
+    {
+        OutEffectsData.Add(*EffectRow);
+    }
+    
+    return FoundAll && OutEffectsData.Num() > 0;
+}
@@ -6,16 +6,61 @@
 #include "AbilityEffectTypes.h"
 #include "EffectDataAsset.generated.h"
 
+struct FStreamableHandle;
+class FObjectPreSaveContext;
+class UScalingCurveDataAsset;
+
+// Shared, immutable copy of one effect row. Holding one keeps the row alive across table reloads
+typedef TSharedPtr<const FEffectTableRow, ESPMode::ThreadSafe> FEffectRowPtr;
+
+// Immutable view of the compiled effect table at one point in time.
+// Unchanged rows are shared with the previous snapshot, so a record obtained from an old snapshot
+// (and its SourceRow) stays valid for as long as the caller holds that snapshot.
+struct MYPROJECT5_API FEffectDataSnapshot
+{
+    // Incremented every time the asset swaps in a new snapshot
+    uint32 Version = 0;
+    
+    // Compiled records in table order. Each SourceRow points into the matching entry of Rows
+    TArray<FCompiledEffectRecord> Records;
+    
+    // Shared row copies, parallel to Records
+    TArray<FEffectRowPtr> Rows;
+    
+    // EffectID -> index into Records
+    TMap<int32, int32> IDIndex;
+    
+    const FCompiledEffectRecord* FindRecord(int32 EffectID) const;
+};
+
+typedef TSharedPtr<const FEffectDataSnapshot, ESPMode::ThreadSafe> FEffectDataSnapshotPtr;
+
+// Broadcast on the game thread after a new snapshot has been swapped in
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnEffectDataSnapshotChanged, const FEffectDataSnapshotPtr& /*NewSnapshot*/);
+
+// Primary asset so the Asset Manager can stream the soft references in the effect table
 UCLASS()
-class MYPROJECT5_API UEffectDataAsset : public UDataAsset
+class MYPROJECT5_API UEffectDataAsset : public UPrimaryDataAsset
 {
     GENERATED_BODY()
     
 public:
+    // Primary asset type every effect data asset is registered under
+    static const FPrimaryAssetType PrimaryAssetType;
+    
     // The data table containing effect definitions
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Effects")
     UDataTable* EffectsDataTable;
     
+    // Named formulas for Custom magnitudes, e.g. "FireballDamage" -> "Base + Intellect * Coeff * (1 + Level / 60)".
+    // A CustomFormula that is not a key here is compiled as an expression itself
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Effects")
+    TMap<FName, FString> CustomFormulas;
+    
+    // Baked level curves for ScaledByLevel magnitudes that name a LevelCurve
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Effects")
+    UScalingCurveDataAsset* ScalingCurves;
+    
     // Get effect data by ID
     UFUNCTION(BlueprintCallable, Category = "Effects")
     bool GetEffectDataByID(int32 EffectID, FEffectTableRow& OutEffectData) const;
@@ -23,4 +68,130 @@ public:
     // Get multiple effect data entries by ID array
     UFUNCTION(BlueprintCallable, Category = "Effects")
     bool GetEffectsDataByIDs(const TArray<int32>& EffectIDs, TArray<FEffectTableRow>& OutEffectsData) const;
+    
+    // Get a pointer to the effect row by ID without copying it (nullptr if not found).
+    // Only valid until the next snapshot swap; hold GetSnapshot() to keep it
+    const FEffectTableRow* FindEffectDataByID(int32 EffectID) const;
+    
+    // Fill the caller's array with row pointers for each ID, skipping missing IDs. Returns true if all were found
+    bool FindEffectsDataByIDs(const TArray<int32>& EffectIDs, TArray<const FEffectTableRow*>& OutEffectsData) const;
+    
+    // Get the compiled runtime record for an effect (nullptr if not found)
+    const FCompiledEffectRecord* FindCompiledEffect(int32 EffectID) const;
+    
+    // The current snapshot. Hold it for the duration of an apply so records cannot be swapped out underneath
+    FEffectDataSnapshotPtr GetSnapshot() const;
+    
+    // Rebuild the snapshot from the data table, recompiling only rows that changed (or every row)
+    void RebuildIndex(bool bRecompileAll = false);
+    
+    // Live hotfix: swap in a snapshot where only these rows (matched by EffectID) are recompiled.
+    // The data table itself is left untouched, so a later reimport wins
+    void PatchEffectRows(const TArray<FEffectTableRow>& ChangedRows);
+    
+    // Fired after every snapshot swap
+    FOnEffectDataSnapshotChanged OnSnapshotChanged;
+    
+    // Stream every GE class (and optionally cosmetic asset) referenced by the table without blocking.
+    // Cosmetics are never streamed on a dedicated server
+    void RequestAsyncPreload(bool bIncludeCosmetics = true);
+    
+    // True while a preload request is still streaming
+    bool IsPreloading() const;
+    
+    // The record's GE default object if its class has finished loading. A newly loaded class is published
+    // in a new snapshot so later lookups take the resolved fast path. Returns nullptr (and makes sure the
+    // class is being streamed) if it is not in memory yet, never blocks
+    const UGameplayEffect* TryResolveEffectClass(const FCompiledEffectRecord& Record);
+    
+    virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+    virtual void PostLoad() override;
+    virtual void BeginDestroy() override;
+    
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+    
+    // Stamp SourceChecksum from the current table, so cooked assets carry it
+    virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+#endif
+    
+    // Checksum of the table's gameplay fields when this asset was last saved or cooked (0 if never).
+    // The combat database stores the same value for the table it was built from
+    uint32 GetSourceChecksum() const { return SourceChecksum; }
+
+#if WITH_EDITORONLY_DATA
+    // GE classes go in the "Gameplay" bundle, VFX and sounds in the client-only "Client" bundle
+    virtual void UpdateAssetBundleData() override;
+#endif
+
+protected:
+    UPROPERTY(VisibleAnywhere, AssetRegistrySearchable, Category = "Effects")
+    uint32 SourceChecksum = 0;
+    
+    // Rebuild the index if the data table was swapped since the last build
+    void EnsureIndexBuilt() const;
+    
+    // Called whenever rows are added, removed or reimported on the bound table
+    void OnEffectsDataTableChanged();
+    
+    // Stop listening to the table the index was built from
+    void UnbindDataTable();
+    
+    // Records hold curves baked by the scaling asset, so a rebake recompiles everything
+    void OnScalingCurvesBaked();
+    
+    void UnbindScalingCurves();
+    
+    // Turn a table row into its runtime record
+    void CompileEffectRecord(const FEffectTableRow& EffectRow, FCompiledEffectRecord& OutRecord);
+    
+    // Resolve one magnitude's stat, level curve or formula
+    void CompileMagnitude(const FEffectTableRow& EffectRow, const FEffectScalingInfo& Scaling, FCompiledEffectMagnitude& OutMagnitude);
+    
+    // Compile a Custom magnitude's formula, nullptr (and a warning) if it does not compile
+    TSharedPtr<const FEffectFormula, ESPMode::ThreadSafe> CompileFormula(const FEffectTableRow& EffectRow, const FEffectScalingInfo& Scaling) const;
+    
+    // Fill in the GE class and CDO on a record if the class is already in memory. Only for records of a
+    // snapshot that has not been published yet
+    bool ResolveRecordClass(FCompiledEffectRecord& Record);
+    
+    // Publish a copy of the current snapshot with every record whose class has loaded since resolved
+    void PublishResolvedClasses();
+    
+    // Publish a new snapshot. Runs on the game thread (or during PostLoad, before anyone can read it)
+    void SwapSnapshot(const TSharedRef<FEffectDataSnapshot, ESPMode::ThreadSafe>& NewSnapshot);
+    
+    // Called when a preload request finishes streaming
+    void OnPreloadComplete();
+    
+    // Drop finished and cancelled handles, moving what finished ones loaded into PreloadedAssets
+    void PruneHandles();
+    
+    // Requests still streaming
+    TArray<TSharedPtr<FStreamableHandle>> PreloadHandles;
+    
+    // Everything a finished preload loaded, kept resident for as long as this asset lives
+    UPROPERTY(Transient)
+    TArray<UObject*> PreloadedAssets;
+    
+    // Remember what was asked for so a table reimport streams the new rows too
+    bool bPreloadRequested = false;
+    bool bPreloadCosmetics = false;
+    
+    // Current snapshot; replaced wholesale, never modified once published
+    FEffectDataSnapshotPtr CurrentSnapshot;
+    
+    // Every GE class a record has resolved, kept here so GC sees the references the snapshots hold
+    UPROPERTY(Transient)
+    TArray<UClass*> ResolvedEffectClasses;
+    
+    // The table the snapshot was built from
+    TWeakObjectPtr<UDataTable> IndexedDataTable;
+    
+    FDelegateHandle DataTableChangedHandle;
+    
+    // The scaling asset the records' level curves came from
+    TWeakObjectPtr<UScalingCurveDataAsset> BoundScalingCurves;
+    
+    FDelegateHandle ScalingCurvesBakedHandle;
 };
\ No newline at end of file
@@ -0,0 +1,642 @@
+// File: EffectFormula.cpp
+#include "EffectFormula.h"
+#include "AbilityEffectTypes.h"
+#include "AbilitySystemComponent.h"
+#include "../Attributes/WoWAttributeSet.h"
+
+namespace
+{
+    int32 GetArity(EEffectFormulaOp Op)
+    {
+        switch (Op)
+        {
+            case EEffectFormulaOp::Const:
+            case EEffectFormulaOp::Level:
+            case EEffectFormulaOp::SourceStat:
+            case EEffectFormulaOp::TargetStat:
+                return 0;
+
+            case EEffectFormulaOp::Neg:
+            case EEffectFormulaOp::Abs:
+            case EEffectFormulaOp::Floor:
+            case EEffectFormulaOp::Ceil:
+                return 1;
+
+            case EEffectFormulaOp::Clamp:
+                return 3;
+
+            default:
+                return 2;
+        }
+    }
+
+    // Shared by constant folding and the interpreter so both always agree
+    float ApplyOp(EEffectFormulaOp Op, const float* Args)
+    {
+        switch (Op)
+        {
+            case EEffectFormulaOp::Add:     return Args[0] + Args[1];
+            case EEffectFormulaOp::Sub:     return Args[0] - Args[1];
+            case EEffectFormulaOp::Mul:     return Args[0] * Args[1];
+            case EEffectFormulaOp::Div:     return Args[1] != 0.0f ? Args[0] / Args[1] : 0.0f;
+            case EEffectFormulaOp::Neg:     return -Args[0];
+            case EEffectFormulaOp::Min:     return FMath::Min(Args[0], Args[1]);
+            case EEffectFormulaOp::Max:     return FMath::Max(Args[0], Args[1]);
+            case EEffectFormulaOp::Clamp:   return FMath::Clamp(Args[0], Args[1], Args[2]);
+            case EEffectFormulaOp::Abs:     return FMath::Abs(Args[0]);
+            case EEffectFormulaOp::Floor:   return FMath::FloorToFloat(Args[0]);
+            case EEffectFormulaOp::Ceil:    return FMath::CeilToFloat(Args[0]);
+            default:                        return 0.0f;
+        }
+    }
+}
+
+// Recursive descent parser producing a small folded expression tree, then flattened to bytecode
+class FEffectFormulaCompiler
+{
+public:
+    FEffectFormulaCompiler(const FString& InSource, const FEffectScalingInfo& InScaling,
+        const TMap<FName, FEffectScalingInfo>& InAdditionalMagnitudes, FEffectFormula& InFormula)
+        : Source(InSource)
+        , Scaling(InScaling)
+        , AdditionalMagnitudes(InAdditionalMagnitudes)
+        , Formula(InFormula)
+    {
+    }
+
+    bool Compile(FString& OutError)
+    {
+        Formula.Code.Reset();
+        Formula.Constants.Reset();
+        Formula.SourceAttributes.Reset();
+        Formula.TargetAttributes.Reset();
+
+        NextToken();
+        const int32 Root = ParseExpression();
+
+        if (Root != INDEX_NONE && Token.Type != ETokenType::End)
+        {
+            Fail(FString::Printf(TEXT("unexpected '%s'"), *Token.Text));
+        }
+
+        int32 Depth = 0;
+        int32 MaxDepth = 0;
+        if (Error.IsEmpty() && Root != INDEX_NONE)
+        {
+            Emit(Root, Depth, MaxDepth);
+        }
+
+        if (Error.IsEmpty() && MaxDepth > FEffectFormula::MaxStackDepth)
+        {
+            Fail(TEXT("formula is nested too deeply"));
+        }
+
+        if (!Error.IsEmpty())
+        {
+            OutError = Error;
+            Formula.Code.Reset();
+            return false;
+        }
+
+        return true;
+    }
+
+private:
+    enum class ETokenType : uint8
+    {
+        Number,
+        Identifier,
+        Symbol,
+        End
+    };
+
+    struct FToken
+    {
+        ETokenType Type = ETokenType::End;
+        float Number = 0.0f;
+        FString Text;
+    };
+
+    struct FNode
+    {
+        EEffectFormulaOp Op = EEffectFormulaOp::Const;
+        float Value = 0.0f;
+        int32 Operand = 0;
+        int32 Children[3] = { INDEX_NONE, INDEX_NONE, INDEX_NONE };
+    };
+
+    void Fail(const FString& Message)
+    {
+        if (Error.IsEmpty())
+        {
+            Error = FString::Printf(TEXT("%s (at %d in \"%s\")"), *Message, Position, *Source);
+        }
+    }
+
+    void NextToken()
+    {
+        while (Position < Source.Len() && FChar::IsWhitespace(Source[Position]))
+        {
+            ++Position;
+        }
+
+        Token = FToken();
+        if (Position >= Source.Len())
+        {
+            return;
+        }
+
+        const int32 Start = Position;
+        const TCHAR C = Source[Position];
+
+        if (FChar::IsDigit(C) || (C == TEXT('.') && Position + 1 < Source.Len() && FChar::IsDigit(Source[Position + 1])))
+        {
+            bool bSeenDecimalPoint = false;
+            while (Position < Source.Len() && (FChar::IsDigit(Source[Position]) || Source[Position] == TEXT('.')))
+            {
+                if (Source[Position] == TEXT('.'))
+                {
+                    // Atof would quietly read "1.2.3" as 1.2
+                    if (bSeenDecimalPoint)
+                    {
+                        Fail(TEXT("malformed number, second decimal point"));
+                    }
+                    bSeenDecimalPoint = true;
+                }
+                ++Position;
+            }
+
+            Token.Type = ETokenType::Number;
+            Token.Text = Source.Mid(Start, Position - Start);
+            Token.Number = FCString::Atof(*Token.Text);
+        }
+        else if (FChar::IsAlpha(C) || C == TEXT('_'))
+        {
+            while (Position < Source.Len() && (FChar::IsAlnum(Source[Position]) || Source[Position] == TEXT('_') || Source[Position] == TEXT('.')))
+            {
+                ++Position;
+            }
+
+            Token.Type = ETokenType::Identifier;
+            Token.Text = Source.Mid(Start, Position - Start);
+        }
+        else
+        {
+            ++Position;
+            Token.Type = ETokenType::Symbol;
+            Token.Text = FString(1, &C);
+        }
+    }
+
+    bool IsSymbol(TCHAR Symbol) const
+    {
+        return Token.Type == ETokenType::Symbol && Token.Text[0] == Symbol;
+    }
+
+    bool Expect(TCHAR Symbol)
+    {
+        if (!IsSymbol(Symbol))
+        {
+            Fail(FString::Printf(TEXT("expected '%c'"), Symbol));
+            return false;
+        }
+
+        NextToken();
+        return true;
+    }
+
+    // Expression := Term (('+' | '-') Term)*
+    int32 ParseExpression()
+    {
+        int32 Left = ParseTerm();
+
+        while (Left != INDEX_NONE && (IsSymbol(TEXT('+')) || IsSymbol(TEXT('-'))))
+        {
+            const EEffectFormulaOp Op = IsSymbol(TEXT('+')) ? EEffectFormulaOp::Add : EEffectFormulaOp::Sub;
+            NextToken();
+
+            const int32 Right = ParseTerm();
+            Left = Right != INDEX_NONE ? MakeOp(Op, Left, Right) : INDEX_NONE;
+        }
+
+        return Left;
+    }
+
+    // Term := Unary (('*' | '/') Unary)*
+    int32 ParseTerm()
+    {
+        int32 Left = ParseUnary();
+
+        while (Left != INDEX_NONE && (IsSymbol(TEXT('*')) || IsSymbol(TEXT('/'))))
+        {
+            const EEffectFormulaOp Op = IsSymbol(TEXT('*')) ? EEffectFormulaOp::Mul : EEffectFormulaOp::Div;
+            NextToken();
+
+            const int32 Right = ParseUnary();
+            Left = Right != INDEX_NONE ? MakeOp(Op, Left, Right) : INDEX_NONE;
+        }
+
+        return Left;
+    }
+
+    // Unary := '-' Unary | Primary
+    int32 ParseUnary()
+    {
+        if (IsSymbol(TEXT('-')))
+        {
+            NextToken();
+
+            const int32 Operand = ParseUnary();
+            return Operand != INDEX_NONE ? MakeOp(EEffectFormulaOp::Neg, Operand) : INDEX_NONE;
+        }
+
+        return ParsePrimary();
+    }
+
+    // Primary := Number | Identifier | Function '(' Args ')' | '(' Expression ')'
+    int32 ParsePrimary()
+    {
+        if (Token.Type == ETokenType::Number)
+        {
+            const float Value = Token.Number;
+            NextToken();
+            return MakeConst(Value);
+        }
+
+        if (IsSymbol(TEXT('(')))
+        {
+            NextToken();
+
+            const int32 Inner = ParseExpression();
+            return (Inner != INDEX_NONE && Expect(TEXT(')'))) ? Inner : INDEX_NONE;
+        }
+
+        if (Token.Type == ETokenType::Identifier)
+        {
+            const FString Name = Token.Text;
+            NextToken();
+
+            if (IsSymbol(TEXT('(')))
+            {
+                return ParseFunction(Name);
+            }
+
+            return ResolveIdentifier(Name);
+        }
+
+        Fail(Token.Type == ETokenType::End ? FString(TEXT("unexpected end of formula")) : FString::Printf(TEXT("unexpected '%s'"), *Token.Text));
+        return INDEX_NONE;
+    }
+
+    int32 ParseFunction(const FString& Name)
+    {
+        EEffectFormulaOp Op;
+        if (Name.Equals(TEXT("min"), ESearchCase::IgnoreCase))          Op = EEffectFormulaOp::Min;
+        else if (Name.Equals(TEXT("max"), ESearchCase::IgnoreCase))     Op = EEffectFormulaOp::Max;
+        else if (Name.Equals(TEXT("clamp"), ESearchCase::IgnoreCase))   Op = EEffectFormulaOp::Clamp;
+        else if (Name.Equals(TEXT("abs"), ESearchCase::IgnoreCase))     Op = EEffectFormulaOp::Abs;
+        else if (Name.Equals(TEXT("floor"), ESearchCase::IgnoreCase))   Op = EEffectFormulaOp::Floor;
+        else if (Name.Equals(TEXT("ceil"), ESearchCase::IgnoreCase))    Op = EEffectFormulaOp::Ceil;
+        else
+        {
+            Fail(FString::Printf(TEXT("unknown function '%s'"), *Name));
+            return INDEX_NONE;
+        }
+
+        // Skip '('
+        NextToken();
+
+        const int32 Arity = GetArity(Op);
+        int32 Args[3] = { INDEX_NONE, INDEX_NONE, INDEX_NONE };
+
+        for (int32 ArgIndex = 0; ArgIndex < Arity; ++ArgIndex)
+        {
+            if (ArgIndex > 0 && !Expect(TEXT(',')))
+            {
+                return INDEX_NONE;
+            }
+
+            Args[ArgIndex] = ParseExpression();
+            if (Args[ArgIndex] == INDEX_NONE)
+            {
+                return INDEX_NONE;
+            }
+        }
+
+        if (!Expect(TEXT(')')))
+        {
+            return INDEX_NONE;
+        }
+
+        return MakeOp(Op, Args[0], Args[1], Args[2]);
+    }
+
+    int32 ResolveIdentifier(const FString& Name)
+    {
+        if (Name.Equals(TEXT("Level"), ESearchCase::IgnoreCase))
+        {
+            FNode Node;
+            Node.Op = EEffectFormulaOp::Level;
+            return Nodes.Add(Node);
+        }
+
+        if (Name.Equals(TEXT("Base"), ESearchCase::IgnoreCase))
+        {
+            return MakeConst(Scaling.BaseValue);
+        }
+
+        if (Name.Equals(TEXT("Coeff"), ESearchCase::IgnoreCase))
+        {
+            return MakeConst(Scaling.ScalingCoefficient);
+        }
+
+        FString Scope;
+        FString Member;
+        if (!Name.Split(TEXT("."), &Scope, &Member))
+        {
+            Member = Name;
+        }
+
+        if (Scope.Equals(TEXT("Mag"), ESearchCase::IgnoreCase))
+        {
+            const FEffectScalingInfo* Magnitude = AdditionalMagnitudes.Find(FName(*Member));
+            if (!Magnitude)
+            {
+                Fail(FString::Printf(TEXT("no additional magnitude named '%s'"), *Member));
+                return INDEX_NONE;
+            }
+
+            return InlineMagnitude(*Magnitude, Member);
+        }
+
+        const bool bTarget = Scope.Equals(TEXT("Target"), ESearchCase::IgnoreCase);
+        if (!Scope.IsEmpty() && !bTarget && !Scope.Equals(TEXT("Source"), ESearchCase::IgnoreCase))
+        {
+            Fail(FString::Printf(TEXT("unknown scope '%s'"), *Scope));
+            return INDEX_NONE;
+        }
+
+        FProperty* Property = FindFProperty<FProperty>(UWoWAttributeSet::StaticClass(), FName(*Member));
+        if (!Property || !FGameplayAttribute::IsGameplayAttributeDataProperty(Property))
+        {
+            Fail(FString::Printf(TEXT("unknown identifier '%s'"), *Name));
+            return INDEX_NONE;
+        }
+
+        return MakeStat(FGameplayAttribute(Property), bTarget);
+    }
+
+    // Splice a secondary magnitude in as an expression so it folds with the rest of the formula
+    int32 InlineMagnitude(const FEffectScalingInfo& Magnitude, const FString& Name)
+    {
+        const int32 Base = MakeConst(Magnitude.BaseValue);
+
+        switch (Magnitude.MagnitudeType)
+        {
+            case EEffectMagnitudeType::Flat:
+                return Base;
+
+            case EEffectMagnitudeType::ScaledByLevel:
+            {
+                // Level curves are baked per record, the bytecode only knows the raw level
+                if (!Magnitude.LevelCurve.IsNone())
+                {
+                    Fail(FString::Printf(TEXT("magnitude '%s' uses level curve %s, which formulas cannot read"), *Name, *Magnitude.LevelCurve.ToString()));
+                    return INDEX_NONE;
+                }
+
+                FNode LevelNode;
+                LevelNode.Op = EEffectFormulaOp::Level;
+                const int32 Level = Nodes.Add(LevelNode);
+                return MakeOp(EEffectFormulaOp::Add, Base, MakeOp(EEffectFormulaOp::Mul, Level, MakeConst(Magnitude.ScalingCoefficient)));
+            }
+
+            case EEffectMagnitudeType::ScaledByStat:
+            {
+                const FGameplayAttribute StatAttribute = UWoWAttributeSet::GetAttributeForStatTag(Magnitude.StatTag);
+                if (!StatAttribute.IsValid())
+                {
+                    Fail(FString::Printf(TEXT("magnitude '%s' scales from unknown stat %s"), *Name, *Magnitude.StatTag.ToString()));
+                    return INDEX_NONE;
+                }
+
+                const int32 Stat = MakeStat(StatAttribute, false);
+                return Stat != INDEX_NONE ? MakeOp(EEffectFormulaOp::Add, Base, MakeOp(EEffectFormulaOp::Mul, Stat, MakeConst(Magnitude.ScalingCoefficient))) : INDEX_NONE;
+            }
+
+            default:
+                Fail(FString::Printf(TEXT("magnitude '%s' is itself a custom formula"), *Name));
+                return INDEX_NONE;
+        }
+    }
+
+    int32 MakeConst(float Value)
+    {
+        FNode Node;
+        Node.Op = EEffectFormulaOp::Const;
+        Node.Value = Value;
+        return Nodes.Add(Node);
+    }
+
+    int32 MakeStat(const FGameplayAttribute& Attribute, bool bTarget)
+    {
+        TArray<FGameplayAttribute>& Attributes = bTarget ? Formula.TargetAttributes : Formula.SourceAttributes;
+
+        int32 AttributeIndex = Attributes.IndexOfByKey(Attribute);
+        if (AttributeIndex == INDEX_NONE)
+        {
+            if (Attributes.Num() >= FEffectFormula::MaxAttributes)
+            {
+                Fail(TEXT("formula reads too many attributes"));
+                return INDEX_NONE;
+            }
+
+            AttributeIndex = Attributes.Add(Attribute);
+        }
+
+        FNode Node;
+        Node.Op = bTarget ? EEffectFormulaOp::TargetStat : EEffectFormulaOp::SourceStat;
+        Node.Operand = AttributeIndex;
+        return Nodes.Add(Node);
+    }
+
+    // Create an operator node, folding it to a constant when every argument is constant
+    int32 MakeOp(EEffectFormulaOp Op, int32 A, int32 B = INDEX_NONE, int32 C = INDEX_NONE)
+    {
+        const int32 Children[3] = { A, B, C };
+        const int32 Arity = GetArity(Op);
+
+        bool bAllConstant = true;
+        float Args[3] = { 0.0f, 0.0f, 0.0f };
+        for (int32 ArgIndex = 0; ArgIndex < Arity; ++ArgIndex)
+        {
+            if (Children[ArgIndex] == INDEX_NONE)
+            {
+                return INDEX_NONE;
+            }
+
+            const FNode& Child = Nodes[Children[ArgIndex]];
+            bAllConstant &= Child.Op == EEffectFormulaOp::Const;
+            Args[ArgIndex] = Child.Value;
+        }
+
+        if (bAllConstant)
+        {
+            return MakeConst(ApplyOp(Op, Args));
+        }
+
+        FNode Node;
+        Node.Op = Op;
+        FMemory::Memcpy(Node.Children, Children, sizeof(Children));
+        return Nodes.Add(Node);
+    }
+
+    // Post-order walk writing instructions and tracking the stack high-water mark
+    void Emit(int32 NodeIndex, int32& Depth, int32& MaxDepth)
+    {
+        const FNode Node = Nodes[NodeIndex];
+        const int32 Arity = GetArity(Node.Op);
+
+        for (int32 ArgIndex = 0; ArgIndex < Arity; ++ArgIndex)
+        {
+            Emit(Node.Children[ArgIndex], Depth, MaxDepth);
+        }
+
+        FEffectFormulaInstruction Instruction;
+        Instruction.Op = Node.Op;
+        Instruction.Operand = 0;
+
+        if (Node.Op == EEffectFormulaOp::Const)
+        {
+            int32 ConstantIndex = Formula.Constants.IndexOfByKey(Node.Value);
+            if (ConstantIndex == INDEX_NONE)
+            {
+                ConstantIndex = Formula.Constants.Add(Node.Value);
+            }
+
+            if (ConstantIndex > MAX_uint8)
+            {
+                Fail(TEXT("formula has too many constants"));
+                return;
+            }
+
+            Instruction.Operand = static_cast<uint8>(ConstantIndex);
+        }
+        else if (Node.Op == EEffectFormulaOp::SourceStat || Node.Op == EEffectFormulaOp::TargetStat)
+        {
+            Instruction.Operand = static_cast<uint8>(Node.Operand);
+        }
+
+        Formula.Code.Add(Instruction);
+
+        // Leaves push one value; operators pop their arguments and push the result
+        Depth += 1 - Arity;
+        MaxDepth = FMath::Max(MaxDepth, Depth);
+    }
+
+    const FString& Source;
+    const FEffectScalingInfo& Scaling;
+    const TMap<FName, FEffectScalingInfo>& AdditionalMagnitudes;
+    FEffectFormula& Formula;
+
+    TArray<FNode> Nodes;
+    FToken Token;
+    int32 Position = 0;
+    FString Error;
+};
+
+bool FEffectFormula::Compile(const FString& Source, const FEffectScalingInfo& Scaling,
+    const TMap<FName, FEffectScalingInfo>& AdditionalMagnitudes, FEffectFormula& OutFormula, FString& OutError)
+{
+    FEffectFormulaCompiler Compiler(Source, Scaling, AdditionalMagnitudes, OutFormula);
+    return Compiler.Compile(OutError);
+}
+
+void FEffectFormula::ReadStats(const UAbilitySystemComponent* ASC, const TArray<FGameplayAttribute>& Attributes, float* OutStats)
+{
+    for (int32 AttributeIndex = 0; AttributeIndex < Attributes.Num(); ++AttributeIndex)
+    {
+        OutStats[AttributeIndex] = ASC ? ASC->GetNumericAttribute(Attributes[AttributeIndex]) : 0.0f;
+    }
+}
+
+float FEffectFormula::Run(float Level, const float* SourceStats, const float* TargetStats) const
+{
+    float Stack[MaxStackDepth];
+    int32 Top = 0;
+
+    for (const FEffectFormulaInstruction& Instruction : Code)
+    {
+        switch (Instruction.Op)
+        {
+            case EEffectFormulaOp::Const:
+                Stack[Top++] = Constants[Instruction.Operand];
+                break;
+
+            case EEffectFormulaOp::Level:
+                Stack[Top++] = Level;
+                break;
+
+            case EEffectFormulaOp::SourceStat:
+                Stack[Top++] = SourceStats[Instruction.Operand];
+                break;
+
+            case EEffectFormulaOp::TargetStat:
+                Stack[Top++] = TargetStats[Instruction.Operand];
+                break;
+
+            default:
+            {
+                // Arguments sit on top of the stack in order, the result replaces the first one
+                Top -= GetArity(Instruction.Op);
+                Stack[Top] = ApplyOp(Instruction.Op, &Stack[Top]);
+                ++Top;
+                break;
+            }
+        }
+    }
+
+    return Top > 0 ? Stack[Top - 1] : 0.0f;
+}
+
+float FEffectFormula::Evaluate(float Level, const UAbilitySystemComponent* SourceASC, const UAbilitySystemComponent* TargetASC) const
+{
+    if (IsConstant())
+    {
+        return Constants[Code[0].Operand];
+    }
+
+    float SourceStats[MaxAttributes];
+    float TargetStats[MaxAttributes];
+    ReadStats(SourceASC, SourceAttributes, SourceStats);
+    ReadStats(TargetASC, TargetAttributes, TargetStats);
+
+    return Run(Level, SourceStats, TargetStats);
+}
+
+void FEffectFormula::EvaluateBatch(float Level, const UAbilitySystemComponent* SourceASC,
+    TArrayView<const UAbilitySystemComponent* const> TargetASCs, TArrayView<float> OutValues) const
+{
+    check(OutValues.Num() >= TargetASCs.Num());
+
+    float SourceStats[MaxAttributes];
+    ReadStats(SourceASC, SourceAttributes, SourceStats);
+
+    // Same value for every target
+    if (!ReadsTarget())
+    {
+        const float Value = Run(Level, SourceStats, nullptr);
+        for (int32 TargetIndex = 0; TargetIndex < TargetASCs.Num(); ++TargetIndex)
+        {
+            OutValues[TargetIndex] = Value;
+        }
+        return;
+    }
+
+    float TargetStats[MaxAttributes];
+    for (int32 TargetIndex = 0; TargetIndex < TargetASCs.Num(); ++TargetIndex)
+    {
+        ReadStats(TargetASCs[TargetIndex], TargetAttributes, TargetStats);
+        OutValues[TargetIndex] = Run(Level, SourceStats, TargetStats);
+    }
+}
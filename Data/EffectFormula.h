@@ -0,0 +1,82 @@
+// File: EffectFormula.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+
+class UAbilitySystemComponent;
+struct FEffectScalingInfo;
+
+// Opcodes for compiled magnitude formulas
+enum class EEffectFormulaOp : uint8
+{
+    Const,          // Push Constants[Operand]
+    Level,          // Push the effect level
+    SourceStat,     // Push SourceAttributes[Operand] read from the source
+    TargetStat,     // Push TargetAttributes[Operand] read from the target
+    Add,
+    Sub,
+    Mul,
+    Div,            // x / 0 evaluates to 0
+    Neg,
+    Min,
+    Max,
+    Clamp,
+    Abs,
+    Floor,
+    Ceil
+};
+
+struct FEffectFormulaInstruction
+{
+    EEffectFormulaOp Op;
+    uint8 Operand;
+};
+
+// Designer magnitude formula for EEffectMagnitudeType::Custom, compiled once at data load into stack bytecode.
+//
+// Numbers, + - * / with the usual precedence, unary minus, parentheses, and
+// min(a, b), max(a, b), clamp(x, lo, hi), abs(x), floor(x), ceil(x). Identifiers (case-insensitive):
+//   Level                        effect level
+//   Base, Coeff                  the scaling info's BaseValue and ScalingCoefficient
+//   Strength / Source.Strength   any UWoWAttributeSet attribute on the source
+//   Target.Armor                 any UWoWAttributeSet attribute on the target
+//   Mag.Slow                     the row's AdditionalMagnitudes entry "Slow" (flat, stat or level scaled)
+// Anything that only involves constants (Base, Coeff, flat Mag.* entries) is folded at compile time.
+class MYPROJECT5_API FEffectFormula
+{
+public:
+    static constexpr int32 MaxStackDepth = 16;
+    static constexpr int32 MaxAttributes = 16;
+
+    // Compile a formula for one scaling entry. Returns false and fills OutError if it does not parse
+    static bool Compile(const FString& Source, const FEffectScalingInfo& Scaling,
+        const TMap<FName, FEffectScalingInfo>& AdditionalMagnitudes, FEffectFormula& OutFormula, FString& OutError);
+
+    // Evaluate for a single target. Either ASC may be null, its stats then read as 0
+    float Evaluate(float Level, const UAbilitySystemComponent* SourceASC, const UAbilitySystemComponent* TargetASC) const;
+
+    // Evaluate for many targets at once. Source stats are read once, and a formula that never reads
+    // target stats runs once for the whole batch. OutValues must be as long as TargetASCs
+    void EvaluateBatch(float Level, const UAbilitySystemComponent* SourceASC,
+        TArrayView<const UAbilitySystemComponent* const> TargetASCs, TArrayView<float> OutValues) const;
+
+    bool IsConstant() const { return Code.Num() == 1 && Code[0].Op == EEffectFormulaOp::Const; }
+
+    bool ReadsTarget() const { return TargetAttributes.Num() > 0; }
+
+    int32 GetCodeSize() const { return Code.Num(); }
+
+private:
+    friend class FEffectFormulaCompiler;
+
+    // Run the bytecode against stats that were already read
+    float Run(float Level, const float* SourceStats, const float* TargetStats) const;
+
+    static void ReadStats(const UAbilitySystemComponent* ASC, const TArray<FGameplayAttribute>& Attributes, float* OutStats);
+
+    TArray<FEffectFormulaInstruction> Code;
+    TArray<float> Constants;
+    TArray<FGameplayAttribute> SourceAttributes;
+    TArray<FGameplayAttribute> TargetAttributes;
+};
@@ -0,0 +1,116 @@
+// File: ScalingCurveDataAsset.cpp
+#include "ScalingCurveDataAsset.h"
+#include "Engine/CurveTable.h"
+#include "Curves/RealCurve.h"
+
+void UScalingCurveDataAsset::PostLoad()
+{
+    Super::PostLoad();
+
+    BakeCurves();
+}
+
+void UScalingCurveDataAsset::BeginDestroy()
+{
+    UnbindCurveTable();
+
+    Super::BeginDestroy();
+}
+
+#if WITH_EDITOR
+void UScalingCurveDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UScalingCurveDataAsset, CurveTable) ||
+        PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UScalingCurveDataAsset, MaxLevel))
+    {
+        BakeCurves();
+    }
+}
+#endif
+
+void UScalingCurveDataAsset::UnbindCurveTable()
+{
+    if (UCurveTable* OldTable = BakedCurveTable.Get())
+    {
+        OldTable->OnCurveTableChanged().Remove(CurveTableChangedHandle);
+    }
+
+    CurveTableChangedHandle.Reset();
+    BakedCurveTable.Reset();
+}
+
+void UScalingCurveDataAsset::BakeCurves()
+{
+    // Re-bind if the table itself was swapped
+    if (BakedCurveTable.Get() != CurveTable)
+    {
+        UnbindCurveTable();
+
+        if (CurveTable)
+        {
+            CurveTableChangedHandle = CurveTable->OnCurveTableChanged().AddUObject(this, &UScalingCurveDataAsset::OnCurveTableChanged);
+            BakedCurveTable = CurveTable;
+        }
+    }
+
+    // Fresh tables rather than in-place edits, anyone holding the old ones keeps consistent values
+    Tables.Reset();
+    bBaked = true;
+
+    if (CurveTable)
+    {
+        const int32 NumLevels = FMath::Max(MaxLevel, 1) + 1;
+
+        for (const TPair<FName, FRealCurve*>& Row : CurveTable->GetRowMap())
+        {
+            if (!Row.Value)
+            {
+                continue;
+            }
+
+            TSharedRef<FLevelScalingTable, ESPMode::ThreadSafe> Table = MakeShared<FLevelScalingTable, ESPMode::ThreadSafe>();
+            Table->Values.SetNumUninitialized(NumLevels);
+
+            for (int32 Level = 0; Level < NumLevels; ++Level)
+            {
+                Table->Values[Level] = Row.Value->Eval(static_cast<float>(Level));
+            }
+
+            Tables.Add(Row.Key, Table);
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("%s: baked %d scaling curves up to level %d"), *GetName(), Tables.Num(), MaxLevel);
+
+    OnCurvesBaked.Broadcast();
+}
+
+void UScalingCurveDataAsset::OnCurveTableChanged()
+{
+    BakeCurves();
+}
+
+void UScalingCurveDataAsset::EnsureBaked() const
+{
+    if (!bBaked || BakedCurveTable.Get() != CurveTable)
+    {
+        // The table was assigned at runtime, bake on first use
+        const_cast<UScalingCurveDataAsset*>(this)->BakeCurves();
+    }
+}
+
+FLevelScalingTablePtr UScalingCurveDataAsset::FindTable(FName CurveName) const
+{
+    EnsureBaked();
+
+    const FLevelScalingTablePtr* Table = Tables.Find(CurveName);
+    return Table ? *Table : nullptr;
+}
+
+float UScalingCurveDataAsset::GetValue(FName CurveName, float Level, float DefaultValue) const
+{
+    const FLevelScalingTablePtr Table = FindTable(CurveName);
+    return Table.IsValid() ? Table->GetValue(Level) : DefaultValue;
+}
@@ -0,0 +1,83 @@
+// File: ScalingCurveDataAsset.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ScalingCurveDataAsset.generated.h"
+
+class UCurveTable;
+
+// One curve sampled at every whole level from 0 to MaxLevel. Immutable once baked and shared,
+// so a holder keeps reading the values it resolved even if the curve table is reimported
+struct MYPROJECT5_API FLevelScalingTable
+{
+    TArray<float> Values;
+
+    // Single indexed read. Levels are rounded to the nearest whole level and clamped to the baked range
+    float GetValue(float Level) const
+    {
+        return Values[FMath::Clamp(FMath::RoundToInt(Level), 0, Values.Num() - 1)];
+    }
+};
+
+typedef TSharedPtr<const FLevelScalingTable, ESPMode::ThreadSafe> FLevelScalingTablePtr;
+
+// Broadcast after the curves were baked again (curve table reimported or swapped)
+DECLARE_MULTICAST_DELEGATE(FOnScalingCurvesBaked);
+
+// Level scaling curves (e.g. "Effect.SpellPower", "Enemy.Melee.Strength") baked from a curve table
+// into dense per-level arrays at load, so runtime lookups never evaluate a curve
+UCLASS()
+class MYPROJECT5_API UScalingCurveDataAsset : public UPrimaryDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    // Source curves, one row per scaling curve
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Scaling")
+    UCurveTable* CurveTable;
+
+    // Highest level to bake. Anything above reads the MaxLevel value
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Scaling", meta = (ClampMin = "1", ClampMax = "1000"))
+    int32 MaxLevel = 60;
+
+    // The baked table for a curve row, nullptr if the row does not exist. Resolve once and keep it
+    FLevelScalingTablePtr FindTable(FName CurveName) const;
+
+    // Curve value at a level, or DefaultValue if the row does not exist
+    UFUNCTION(BlueprintCallable, Category = "Scaling")
+    float GetValue(FName CurveName, float Level, float DefaultValue) const;
+
+    // Sample every curve again
+    void BakeCurves();
+
+    // Fired after every bake
+    FOnScalingCurvesBaked OnCurvesBaked;
+
+    virtual void PostLoad() override;
+    virtual void BeginDestroy() override;
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+protected:
+    // Bake if the curve table was swapped since the last bake
+    void EnsureBaked() const;
+
+    // Called whenever the bound curve table is reimported or edited
+    void OnCurveTableChanged();
+
+    // Stop listening to the table the curves were baked from
+    void UnbindCurveTable();
+
+    // Curve row name -> baked samples
+    TMap<FName, FLevelScalingTablePtr> Tables;
+
+    // The table the current samples came from
+    TWeakObjectPtr<UCurveTable> BakedCurveTable;
+
+    bool bBaked = false;
+
+    FDelegateHandle CurveTableChangedHandle;
+};
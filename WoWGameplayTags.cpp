@@ -0,0 +1,34 @@
+// File: WoWGameplayTags.cpp
+#include "WoWGameplayTags.h"
+
+namespace WoWGameplayTags
+{
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(Data_Damage, "Data.Damage", "SetByCaller damage magnitude");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(Data_Healing, "Data.Healing", "SetByCaller healing magnitude");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(Data_Magnitude, "Data.Magnitude", "SetByCaller magnitude for other effect types");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(Data_Cooldown, "Data.Cooldown", "SetByCaller cooldown duration");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(Data_AbilityID, "Data.AbilityID", "SetByCaller ID of the ability a cooldown belongs to");
+    
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(Ability_Cooldown, "Ability.Cooldown", "Parent of every ability cooldown tag");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(Ability_Cooldown_Spell_Fireball, "Ability.Cooldown.Spell.Fireball", "Fallback cooldown for abilities without a cooldown tag");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(Enemy_Attack_Cooldown, "Enemy.Attack.Cooldown", "Enemy melee attack is cooling down");
+    
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(Ability_Attack_Melee, "Ability.Attack.Melee", "Melee auto attack ability");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(Ability_AutoAttack_Active, "Ability.AutoAttack.Active", "Auto attack is toggled on");
+    
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(State_Stunned, "State.Stunned", "Granted by stun effects, blocks attacks and abilities");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(State_Dead, "State.Dead", "Health reached zero");
+    
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(GameplayCue_Effect_Applied, "GameplayCue.Effect.Applied", "Application VFX and sound of an effect table row");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(GameplayCue_Effect_Applied_Visual, "GameplayCue.Effect.Applied.Visual", "Application VFX only, for area targets sharing one sound");
+    UE_DEFINE_GAMEPLAY_TAG_COMMENT(GameplayCue_Effect_Persistent, "GameplayCue.Effect.Persistent", "Persistent VFX and sound of a duration effect");
+    
+    UE_DEFINE_GAMEPLAY_TAG(GameplayCue_Effect_Persistent_Slot0, "GameplayCue.Effect.Persistent.Slot0");
+    UE_DEFINE_GAMEPLAY_TAG(GameplayCue_Effect_Persistent_Slot1, "GameplayCue.Effect.Persistent.Slot1");
+    UE_DEFINE_GAMEPLAY_TAG(GameplayCue_Effect_Persistent_Slot2, "GameplayCue.Effect.Persistent.Slot2");
+    UE_DEFINE_GAMEPLAY_TAG(GameplayCue_Effect_Persistent_Slot3, "GameplayCue.Effect.Persistent.Slot3");
+    UE_DEFINE_GAMEPLAY_TAG(GameplayCue_Effect_Persistent_Slot4, "GameplayCue.Effect.Persistent.Slot4");
+    UE_DEFINE_GAMEPLAY_TAG(GameplayCue_Effect_Persistent_Slot5, "GameplayCue.Effect.Persistent.Slot5");
+    UE_DEFINE_GAMEPLAY_TAG(GameplayCue_Effect_Persistent_Slot6, "GameplayCue.Effect.Persistent.Slot6");
+    UE_DEFINE_GAMEPLAY_TAG(GameplayCue_Effect_Persistent_Slot7, "GameplayCue.Effect.Persistent.Slot7");
+}
@@ -0,0 +1,45 @@
+// File: WoWGameplayTags.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NativeGameplayTags.h"
+
+// Native gameplay tags used by the combat code. They are registered with the tag manager when the
+// module loads, so using one is a static load instead of a name lookup and tag search
+namespace WoWGameplayTags
+{
+    // SetByCaller channels
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Data_Damage);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Data_Healing);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Data_Magnitude);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Data_Cooldown);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Data_AbilityID);
+    
+    // Cooldowns
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Cooldown);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Cooldown_Spell_Fireball);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Enemy_Attack_Cooldown);
+    
+    // Auto attack
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_Attack_Melee);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Ability_AutoAttack_Active);
+    
+    // Character states
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Stunned);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(State_Dead);
+    
+    // Effect feedback cues
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayCue_Effect_Applied);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayCue_Effect_Applied_Visual);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayCue_Effect_Persistent);
+    
+    // One persistent feedback slot per tag, so removing a slot's cue removes exactly that effect's visuals
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayCue_Effect_Persistent_Slot0);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayCue_Effect_Persistent_Slot1);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayCue_Effect_Persistent_Slot2);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayCue_Effect_Persistent_Slot3);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayCue_Effect_Persistent_Slot4);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayCue_Effect_Persistent_Slot5);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayCue_Effect_Persistent_Slot6);
+    MYPROJECT5_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(GameplayCue_Effect_Persistent_Slot7);
+}